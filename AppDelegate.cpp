@@ -1,5 +1,13 @@
 #include "AppDelegate.h"
+#include "AudioMixer.h"
+#include "FramePacer.h"
+#include "InputLatencyHarness.h"
 #include "MenuScene.h"
+#include "RenderStats.h"
+#include "SpinTable.h"
+#include "TennisScene.h"
+#include <cstdlib>
+#include <cstring>
 
 USING_NS_CC;
 
@@ -16,6 +24,7 @@ namespace EpicGame {
 
     AppDelegate::~AppDelegate()
     {
+        AudioMixer::getInstance()->shutdown();
     }
 
     void AppDelegate::initGLContextAttrs()
@@ -28,18 +37,49 @@ namespace EpicGame {
     {
         auto director = Director::getInstance();
         auto glview = director->getOpenGLView();
+        bool exporting = !exportReplayPath.empty();
+        bool measuringLatency = latencyTrials > 0;
 
         if (!glview) {
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
-            glview = GLViewImpl::createWithRect("Tennis Game", cocos2d::Rect(0, 0, designResolutionSize.width, designResolutionSize.height));
+            cocos2d::Rect windowRect(0, 0, designResolutionSize.width, designResolutionSize.height);
+            // InputLatencyHarness mide present al volver de swapBuffers.
+            if (measuringLatency) {
+                glview = PresentTimingView::createWithRect("Tennis Game", windowRect);
+            }
+            else {
+                glview = GLViewImpl::createWithRect("Tennis Game", windowRect);
+            }
 #else
             glview = GLViewImpl::create("Tennis Game");
 #endif
             director->setOpenGLView(glview);
         }
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+        // Se sigue necesitando un contexto GL; en Linux sin pantalla vale con
+        // xvfb-run y el renderizador por software de Mesa.
+        if (exporting) {
+            glfwHideWindow(static_cast<GLViewImpl*>(glview)->getWindow());
+        }
+#endif
 
-        director->setDisplayStats(true);
-        director->setAnimationInterval(1.0f / 60);
+        director->setDisplayStats(!exporting);
+        if (!exporting && !measuringLatency) {
+            // F3 muestra el panel de RenderStats, F2 guarda el historial en CSV.
+            RenderStats::getInstance()->install();
+        }
+        director->setAnimationInterval(exporting ? 1.0f / 1000 : 1.0f / 60);
+        if (!exporting && !measuringLatency) {
+            // Menu y esperas a ritmo bajo; el peloteo al refresco de la pantalla.
+            float refreshRate = FramePacer::NORMAL_RATE;
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+            const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+            if (mode) {
+                refreshRate = static_cast<float>(mode->refreshRate);
+            }
+#endif
+            FramePacer::getInstance()->install(refreshRate);
+        }
 
         glview->setDesignResolutionSize(
             designResolutionSize.width,
@@ -62,6 +102,35 @@ namespace EpicGame {
         }
 
         FileUtils::getInstance()->addSearchPath("Resources");
+        // Despues de la ruta de Resources: busca ahi los WAV de sfx/.
+        if (!exporting && !AudioMixer::getInstance()->init()) {
+            CCLOG("Error: No se pudo iniciar el audio; se juega sin sonido");
+        }
+        // Trayectorias con efecto: unos ms ahora y no en el primer golpe.
+        SpinTable::getInstance();
+
+        if (exporting) {
+            auto scene = TennisScene::createReplayExport(exportReplayPath, exportDirectory,
+                exportRaw ? FrameEncoder::Format::RAW : FrameEncoder::Format::PNG);
+            if (!scene) {
+                CCLOG("Error: No se pudo exportar %s", exportReplayPath.c_str());
+                director->end();
+                return true;
+            }
+            director->runWithScene(scene);
+            return true;
+        }
+
+        if (measuringLatency) {
+            auto scene = TennisScene::createInputLatencyTest(latencyTrials, latencyPrefix, latencyStressRate);
+            if (!scene) {
+                CCLOG("Error: No se pudo crear la prueba de latencia");
+                director->end();
+                return true;
+            }
+            director->runWithScene(scene);
+            return true;
+        }
 
         auto scene = MenuScene::createScene();
         director->runWithScene(scene);
@@ -69,6 +138,34 @@ namespace EpicGame {
         return true;
     }
 
+    bool AppDelegate::parseReplayExportArgs(int argc, char* argv[])
+    {
+        for (int i = 1; i + 2 < argc; i++) {
+            if (strcmp(argv[i], "--export-replay") == 0) {
+                exportReplayPath = argv[i + 1];
+                exportDirectory = argv[i + 2];
+                exportRaw = i + 3 < argc && strcmp(argv[i + 3], "--raw") == 0;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool AppDelegate::parseInputLatencyArgs(int argc, char* argv[])
+    {
+        for (int i = 1; i + 2 < argc; i++) {
+            if (strcmp(argv[i], "--input-latency") == 0) {
+                latencyTrials = atoi(argv[i + 1]);
+                latencyPrefix = argv[i + 2];
+                if (i + 4 < argc && strcmp(argv[i + 3], "--stress") == 0) {
+                    latencyStressRate = atoi(argv[i + 4]);
+                }
+                return latencyTrials > 0;
+            }
+        }
+        return false;
+    }
+
     void AppDelegate::applicationDidEnterBackground()
     {
         Director::getInstance()->stopAnimation();
@@ -77,6 +174,8 @@ namespace EpicGame {
     void AppDelegate::applicationWillEnterForeground()
     {
         Director::getInstance()->startAnimation();
+        // Aunque la escena estuviera parada, se redibuja al volver.
+        FramePacer::getInstance()->onInput();
     }
 
 } 
\ No newline at end of file
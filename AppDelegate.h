@@ -2,6 +2,7 @@
 #define __APP_DELEGATE_H__
 
 #include "cocos2d.h"
+#include <string>
 
 namespace EpicGame {
 
@@ -16,6 +17,22 @@ namespace EpicGame {
         virtual bool applicationDidFinishLaunching();
         virtual void applicationDidEnterBackground();
         virtual void applicationWillEnterForeground();
+
+        // --export-replay partido.rpl directorio [--raw]: exporta la repeticion
+        // a imagenes con la ventana oculta y cierra. Devuelve false si los
+        // argumentos no son de exportacion.
+        bool parseReplayExportArgs(int argc, char* argv[]);
+        // --input-latency pruebas prefijo [--stress eventos/s]: mide la
+        // latencia de golpe con InputLatencyHarness y cierra.
+        bool parseInputLatencyArgs(int argc, char* argv[]);
+
+    private:
+        std::string exportReplayPath;
+        std::string exportDirectory;
+        bool exportRaw = false;
+        int latencyTrials = 0;
+        std::string latencyPrefix;
+        int latencyStressRate = 0;
     };
 
 } 
@@ -0,0 +1,555 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <Windows.h>
+#include <mmsystem.h>
+#include "OpenalSoft/al.h"
+#include "OpenalSoft/alc.h"
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
+#include <OpenAL/al.h>
+#include <OpenAL/alc.h>
+#else
+#include <AL/al.h>
+#include <AL/alc.h>
+#endif
+
+// Extensiones de OpenAL Soft; se buscan en tiempo de ejecucion.
+#ifndef AL_SEC_OFFSET_LATENCY_SOFT
+#define AL_SEC_OFFSET_LATENCY_SOFT 0x1201
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AUDIO_MIXER_SSE 1
+#endif
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        const char* const SAMPLE_FILES[] = { "sfx/hit.wav", "sfx/serve.wav", "sfx/bounce.wav", "sfx/fault.wav", "sfx/cheer.wav" };
+        const float PI = 3.14159265f;
+        const double BLOCK_SECONDS = static_cast<double>(AudioMixer::BLOCK_FRAMES) / AudioMixer::SAMPLE_RATE;
+
+        typedef ALCboolean (ALC_APIENTRY* SetThreadContextFunction)(ALCcontext* context);
+        typedef void (AL_APIENTRY* GetSourcedvFunction)(ALuint source, ALenum param, ALdouble* values);
+
+        uint32_t readU32(const unsigned char* p) {
+            return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        uint16_t readU16(const unsigned char* p) {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+    }
+
+    AudioMixer* AudioMixer::getInstance() {
+        static AudioMixer instance;
+        return &instance;
+    }
+
+    double AudioMixer::getTime() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    AudioMixer::~AudioMixer() {
+        shutdown();
+    }
+
+    bool AudioMixer::init() {
+        if (running) {
+            return true;
+        }
+        loadSamples();
+        if (!openDevice()) {
+            CCLOG("Error: No se pudo abrir el dispositivo de audio");
+            return false;
+        }
+
+        for (Voice& voice : voices) {
+            voice = Voice();
+        }
+        std::fill(latencyBins, latencyBins + LATENCY_BINS, 0u);
+        latencyCount = 0;
+        maxLatencyMicros = 0;
+        running = true;
+        thread = std::thread(&AudioMixer::mixerLoop, this);
+        return true;
+    }
+
+    void AudioMixer::shutdown() {
+        if (!running) {
+            return;
+        }
+        running = false;
+        if (thread.joinable()) {
+            thread.join();
+        }
+        closeDevice();
+        CCLOG("Audio: paso a salida p50 %.2f ms, p99 %.2f ms, max %.2f ms en %u sonidos (objetivo %d ms); "
+            "%u cortes, %u ordenes perdidas", latencyPercentileMs(0.5), latencyPercentileMs(0.99), getMaxLatencyMs(),
+            latencyCount, TARGET_LATENCY_MS, getUnderruns(), getDroppedCommands());
+    }
+
+    double AudioMixer::latencyPercentileMs(double percentile) const {
+        if (latencyCount == 0) {
+            return 0.0;
+        }
+        uint32_t rank = static_cast<uint32_t>(percentile * (latencyCount - 1));
+        uint32_t seen = 0;
+        for (int bin = 0; bin < LATENCY_BINS; bin++) {
+            seen += latencyBins[bin];
+            if (seen > rank) {
+                return (bin + 1) * LATENCY_BIN_MS;
+            }
+        }
+        return LATENCY_BINS * LATENCY_BIN_MS;
+    }
+
+    void AudioMixer::play(Sound sound, float gain, float pan, double stepTime) {
+        if (!running.load(std::memory_order_relaxed)) {
+            return;
+        }
+        Command command;
+        command.sound = sound;
+        command.gain = std::min(std::max(gain, 0.0f), 1.0f);
+        command.pan = std::min(std::max(pan, -1.0f), 1.0f);
+        command.stepTime = stepTime > 0.0 ? stepTime : getTime();
+        if (!commands.push(command)) {
+            droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void AudioMixer::playEvent(const MatchEvent& event, float width, double stepTime) {
+        float pan = width > 0.0f ? event.x / width * 2.0f - 1.0f : 0.0f;
+        float speed = std::sqrt(event.vx * event.vx + event.vy * event.vy);
+
+        switch (event.type) {
+        case MatchEventType::SERVE:
+            play(SERVE, 0.9f, pan, stepTime);
+            break;
+        case MatchEventType::SHOT_HIT:
+            // Mas fuerte cuanto mas rapida sale la pelota.
+            play(HIT, 0.5f + std::min(speed / 1400.0f, 0.5f), pan, stepTime);
+            break;
+        case MatchEventType::BOUNCE:
+            play(BOUNCE, 0.7f, pan, stepTime);
+            break;
+        case MatchEventType::FAULT:
+            play(FAULT, 0.6f, 0.0f, stepTime);
+            break;
+        case MatchEventType::POINT_WON:
+            play(CHEER, 0.8f, event.player == 1 ? -0.3f : 0.3f, stepTime);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void AudioMixer::loadSamples() {
+        for (int sound = 0; sound < SOUND_COUNT; sound++) {
+            samples[sound].clear();
+            if (!FileUtils::getInstance()->isFileExist(SAMPLE_FILES[sound]) ||
+                !decodeWav(FileUtils::getInstance()->fullPathForFilename(SAMPLE_FILES[sound]), samples[sound])) {
+                synthesize(static_cast<Sound>(sound), samples[sound]);
+            }
+        }
+    }
+
+    // WAV PCM de 8 o 16 bits, mono o estereo, a cualquier frecuencia: se pasa
+    // a mono float y se remuestrea a SAMPLE_RATE con interpolacion lineal.
+    bool AudioMixer::decodeWav(const std::string& path, std::vector<float>& pcm) const {
+        Data data = FileUtils::getInstance()->getDataFromFile(path);
+        const unsigned char* bytes = data.getBytes();
+        size_t size = static_cast<size_t>(data.getSize());
+        if (size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0) {
+            CCLOG("Error: %s no es un WAV", path.c_str());
+            return false;
+        }
+
+        int channels = 0;
+        int rate = 0;
+        int bits = 0;
+        const unsigned char* samplesStart = nullptr;
+        size_t samplesSize = 0;
+        for (size_t offset = 12; offset + 8 <= size;) {
+            uint32_t chunkSize = readU32(bytes + offset + 4);
+            const unsigned char* chunk = bytes + offset + 8;
+            if (chunkSize > size - offset - 8) {
+                break;
+            }
+            if (memcmp(bytes + offset, "fmt ", 4) == 0 && chunkSize >= 16) {
+                if (readU16(chunk) != 1) {
+                    CCLOG("Error: %s no es PCM", path.c_str());
+                    return false;
+                }
+                channels = readU16(chunk + 2);
+                rate = static_cast<int>(readU32(chunk + 4));
+                bits = readU16(chunk + 14);
+            }
+            else if (memcmp(bytes + offset, "data", 4) == 0) {
+                samplesStart = chunk;
+                samplesSize = chunkSize;
+            }
+            offset += 8 + chunkSize + (chunkSize & 1);
+        }
+
+        if (!samplesStart || (channels != 1 && channels != 2) || (bits != 8 && bits != 16) || rate <= 0) {
+            CCLOG("Error: Formato de %s no soportado", path.c_str());
+            return false;
+        }
+
+        size_t frameBytes = static_cast<size_t>(channels) * bits / 8;
+        size_t frames = samplesSize / frameBytes;
+        std::vector<float> source(frames);
+        for (size_t frame = 0; frame < frames; frame++) {
+            float sum = 0.0f;
+            for (int channel = 0; channel < channels; channel++) {
+                const unsigned char* p = samplesStart + frame * frameBytes + channel * (bits / 8);
+                sum += bits == 16 ? static_cast<int16_t>(readU16(p)) / 32768.0f : (p[0] - 128) / 128.0f;
+            }
+            source[frame] = sum / channels;
+        }
+
+        double step = static_cast<double>(rate) / SAMPLE_RATE;
+        size_t outFrames = frames > 0 ? static_cast<size_t>((frames - 1) / step) + 1 : 0;
+        pcm.resize(outFrames);
+        for (size_t i = 0; i < outFrames; i++) {
+            double position = i * step;
+            size_t index = static_cast<size_t>(position);
+            float t = static_cast<float>(position - index);
+            float next = index + 1 < frames ? source[index + 1] : source[index];
+            pcm[i] = source[index] + (next - source[index]) * t;
+        }
+        return !pcm.empty();
+    }
+
+    // Sonidos de relleno mientras no haya WAV: golpes cortos con ruido,
+    // bote grave, pitido de falta y aplauso de ruido filtrado.
+    void AudioMixer::synthesize(Sound sound, std::vector<float>& pcm) const {
+        std::minstd_rand rng(1234 + sound);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        const float rate = static_cast<float>(SAMPLE_RATE);
+
+        switch (sound) {
+        case HIT:
+        case SERVE: {
+            float pitch = sound == HIT ? 1200.0f : 950.0f;
+            pcm.resize(SAMPLE_RATE * 6 / 100);
+            for (size_t i = 0; i < pcm.size(); i++) {
+                float t = i / rate;
+                float envelope = std::exp(-t * 90.0f);
+                pcm[i] = envelope * (0.6f * std::sin(2.0f * PI * pitch * t) + 0.4f * noise(rng));
+            }
+            break;
+        }
+        case BOUNCE:
+            pcm.resize(SAMPLE_RATE * 8 / 100);
+            for (size_t i = 0; i < pcm.size(); i++) {
+                float t = i / rate;
+                float pitch = 220.0f - 900.0f * t;
+                pcm[i] = std::exp(-t * 50.0f) * std::sin(2.0f * PI * pitch * t);
+            }
+            break;
+        case FAULT:
+            pcm.resize(SAMPLE_RATE / 4);
+            for (size_t i = 0; i < pcm.size(); i++) {
+                float t = i / rate;
+                float square = std::sin(2.0f * PI * 440.0f * t) > 0.0f ? 0.35f : -0.35f;
+                pcm[i] = square * std::min(1.0f, (pcm.size() - i) / (rate * 0.02f));
+            }
+            break;
+        case CHEER: {
+            pcm.resize(SAMPLE_RATE * 3 / 2);
+            float low = 0.0f;
+            for (size_t i = 0; i < pcm.size(); i++) {
+                float t = i / rate;
+                float envelope = std::min(t / 0.15f, 1.0f) * std::exp(-std::max(t - 0.3f, 0.0f) * 2.5f);
+                low += (noise(rng) - low) * 0.15f;
+                pcm[i] = 0.7f * envelope * low;
+            }
+            break;
+        }
+        default:
+            pcm.clear();
+            break;
+        }
+    }
+
+    bool AudioMixer::openDevice() {
+        ALCdevice* alDevice = alcOpenDevice(nullptr);
+        if (!alDevice) {
+            return false;
+        }
+        const ALCint attributes[] = { ALC_FREQUENCY, SAMPLE_RATE, ALC_REFRESH, DEVICE_REFRESH, 0 };
+        ALCcontext* alContext = alcCreateContext(alDevice, attributes);
+        if (!alContext) {
+            alcCloseDevice(alDevice);
+            return false;
+        }
+        device = alDevice;
+        context = alContext;
+        threadContextFunction = alcIsExtensionPresent(alDevice, "ALC_EXT_thread_local_context") ?
+            alcGetProcAddress(alDevice, "alcSetThreadContext") : nullptr;
+        // Sin contexto por hilo este es el unico alcMakeContextCurrent hasta closeDevice.
+        if (!(threadContextFunction ? setThreadContext(true) : alcMakeContextCurrent(alContext))) {
+            threadContextFunction = nullptr;
+            alcDestroyContext(alContext);
+            alcCloseDevice(alDevice);
+            context = nullptr;
+            device = nullptr;
+            return false;
+        }
+        sourceLatencyFunction = alIsExtensionPresent("AL_SOFT_source_latency") ?
+            alGetProcAddress("alGetSourcedvSOFT") : nullptr;
+
+        // La cola cabe en el objetivo dejando un bloque para recoger la orden,
+        // salvo que el dispositivo pida mas: entonces dos periodos.
+        ALCint frequency = 0;
+        ALCint refresh = 0;
+        alcGetIntegerv(alDevice, ALC_FREQUENCY, 1, &frequency);
+        alcGetIntegerv(alDevice, ALC_REFRESH, 1, &refresh);
+        int periodFrames = DEFAULT_PERIOD_FRAMES;
+        if (frequency > 0 && refresh > 0) {
+            periodFrames = static_cast<int>(static_cast<int64_t>(SAMPLE_RATE) / refresh);
+        }
+        int targetBlocks = TARGET_LATENCY_MS * SAMPLE_RATE / 1000 / BLOCK_FRAMES - 1;
+        int periodBlocks = (2 * periodFrames + BLOCK_FRAMES - 1) / BLOCK_FRAMES;
+        queuedBlocks = std::min(std::max(targetBlocks, periodBlocks), MAX_QUEUED_BLOCKS);
+        CCLOG("Audio: %d Hz, %d periodos/s, %d bloques en cola (%.1f ms)%s%s", frequency, refresh, queuedBlocks,
+            queuedBlocks * BLOCK_SECONDS * 1000.0, threadContextFunction ? "" : ", contexto global",
+            sourceLatencyFunction ? "" : ", sin latencia del dispositivo");
+        if (periodBlocks > targetBlocks) {
+            CCLOG("Aviso: Con periodos de %d frames la cola no cabe en %d ms", periodFrames, TARGET_LATENCY_MS);
+        }
+
+        alGenSources(1, &source);
+        alGenBuffers(queuedBlocks, buffers);
+        if (alGetError() != AL_NO_ERROR) {
+            closeDevice();
+            return false;
+        }
+
+        // Silencio para arrancar; el hilo va rellenando los que se consumen.
+        memset(blockPcm, 0, sizeof(blockPcm));
+        for (int i = 0; i < queuedBlocks; i++) {
+            alBufferData(buffers[i], AL_FORMAT_STEREO16, blockPcm, sizeof(blockPcm), SAMPLE_RATE);
+        }
+        alSourceQueueBuffers(source, queuedBlocks, buffers);
+        alSourcePlay(source);
+        bool ok = alGetError() == AL_NO_ERROR;
+        // Con contexto por hilo, a partir de aqui es del hilo de mezcla.
+        if (threadContextFunction) {
+            setThreadContext(false);
+        }
+        return ok;
+    }
+
+    void AudioMixer::closeDevice() {
+        if (!context) {
+            return;
+        }
+        if (threadContextFunction) {
+            setThreadContext(true);
+        }
+        alSourceStop(source);
+        alDeleteSources(1, &source);
+        alDeleteBuffers(queuedBlocks, buffers);
+        if (threadContextFunction) {
+            setThreadContext(false);
+        }
+        else {
+            alcMakeContextCurrent(nullptr);
+        }
+        alcDestroyContext(static_cast<ALCcontext*>(context));
+        alcCloseDevice(static_cast<ALCdevice*>(device));
+        context = nullptr;
+        device = nullptr;
+        threadContextFunction = nullptr;
+        sourceLatencyFunction = nullptr;
+    }
+
+    // Contexto del hilo que llama, solo con ALC_EXT_thread_local_context.
+    bool AudioMixer::setThreadContext(bool current) {
+        auto function = reinterpret_cast<SetThreadContextFunction>(threadContextFunction);
+        return function(current ? static_cast<ALCcontext*>(context) : nullptr) != 0;
+    }
+
+    // Segundos hasta que suene el primer frame de un bloque encolado ahora:
+    // lo que queda sin reproducir en la cola de la fuente y la latencia del
+    // dispositivo, si OpenAL la da.
+    double AudioMixer::measureOutputDelay() {
+        ALint queued = 0;
+        alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+        double offset = 0.0;
+        double deviceLatency = 0.0;
+        if (sourceLatencyFunction) {
+            ALdouble values[2] = {};
+            reinterpret_cast<GetSourcedvFunction>(sourceLatencyFunction)(source, AL_SEC_OFFSET_LATENCY_SOFT, values);
+            offset = values[0];
+            deviceLatency = values[1];
+        }
+        else {
+            ALint sampleOffset = 0;
+            alGetSourcei(source, AL_SAMPLE_OFFSET, &sampleOffset);
+            offset = static_cast<double>(sampleOffset) / SAMPLE_RATE;
+        }
+        return std::max(queued * BLOCK_SECONDS - offset, 0.0) + deviceLatency;
+    }
+
+    void AudioMixer::mixerLoop() {
+        if (threadContextFunction) {
+            setThreadContext(true);
+        }
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        // Sin esto sleep_for duerme al menos 15.6 ms y no hay margen de 5 ms.
+        timeBeginPeriod(1);
+#endif
+
+        while (running.load(std::memory_order_relaxed)) {
+            takeCommands();
+
+            ALint processed = 0;
+            alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+            while (processed-- > 0) {
+                ALuint buffer = 0;
+                alSourceUnqueueBuffers(source, 1, &buffer);
+                mixBlock(blockPcm);
+                alBufferData(buffer, AL_FORMAT_STEREO16, blockPcm, sizeof(blockPcm), SAMPLE_RATE);
+                alSourceQueueBuffers(source, 1, &buffer);
+            }
+
+            ALint state = AL_PLAYING;
+            alGetSourcei(source, AL_SOURCE_STATE, &state);
+            if (state != AL_PLAYING) {
+                // Se vacio la cola: se rellena en la siguiente vuelta.
+                underruns.fetch_add(1, std::memory_order_relaxed);
+                alSourcePlay(source);
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(POLL_MICROSECONDS));
+        }
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        timeEndPeriod(1);
+#endif
+        if (threadContextFunction) {
+            setThreadContext(false);
+        }
+    }
+
+    void AudioMixer::takeCommands() {
+        Command command;
+        while (commands.pop(command)) {
+            const std::vector<float>& sample = samples[command.sound];
+            if (sample.empty()) {
+                continue;
+            }
+
+            // Voz libre o, si no hay, la que mas ha sonado ya.
+            Voice* target = &voices[0];
+            for (Voice& voice : voices) {
+                if (!voice.data) {
+                    target = &voice;
+                    break;
+                }
+                if (voice.position > target->position) {
+                    target = &voice;
+                }
+            }
+
+            // Pan de potencia constante.
+            float angle = (command.pan + 1.0f) * 0.25f * PI;
+            target->data = sample.data();
+            target->length = static_cast<int>(sample.size());
+            target->position = 0;
+            target->gainLeft = command.gain * std::cos(angle);
+            target->gainRight = command.gain * std::sin(angle);
+            target->triggerTime = command.stepTime;
+            target->started = false;
+        }
+    }
+
+    void AudioMixer::mixBlock(int16_t* output) {
+        memset(mixLeft, 0, sizeof(mixLeft));
+        memset(mixRight, 0, sizeof(mixRight));
+        // Se mide solo si empieza alguna voz; el bloque aun no esta encolado.
+        double outputTime = 0.0;
+
+        for (Voice& voice : voices) {
+            if (!voice.data) {
+                continue;
+            }
+            if (!voice.started) {
+                if (outputTime == 0.0) {
+                    outputTime = getTime() + measureOutputDelay();
+                }
+                double latency = outputTime - voice.triggerTime;
+                uint32_t micros = static_cast<uint32_t>(std::max(latency, 0.0) * 1e6);
+                if (micros > maxLatencyMicros.load(std::memory_order_relaxed)) {
+                    maxLatencyMicros.store(micros, std::memory_order_relaxed);
+                }
+                int bin = static_cast<int>(latency * 1000.0 / LATENCY_BIN_MS);
+                latencyBins[std::min(std::max(bin, 0), LATENCY_BINS - 1)]++;
+                latencyCount++;
+                voice.started = true;
+            }
+
+            int count = std::min(BLOCK_FRAMES, voice.length - voice.position);
+            mixVoice(voice.data + voice.position, count, voice.gainLeft, voice.gainRight, mixLeft, mixRight);
+            voice.position += count;
+            if (voice.position >= voice.length) {
+                voice.data = nullptr;
+            }
+        }
+
+        toPcm16(mixLeft, mixRight, BLOCK_FRAMES, output);
+    }
+
+    void AudioMixer::mixVoice(const float* input, int count, float gainLeft, float gainRight, float* left, float* right) {
+        int i = 0;
+#if defined(AUDIO_MIXER_SSE)
+        const __m128 gainL = _mm_set1_ps(gainLeft);
+        const __m128 gainR = _mm_set1_ps(gainRight);
+        for (; i + 4 <= count; i += 4) {
+            __m128 in = _mm_loadu_ps(input + i);
+            _mm_store_ps(left + i, _mm_add_ps(_mm_load_ps(left + i), _mm_mul_ps(in, gainL)));
+            _mm_store_ps(right + i, _mm_add_ps(_mm_load_ps(right + i), _mm_mul_ps(in, gainR)));
+        }
+#endif
+        for (; i < count; i++) {
+            left[i] += input[i] * gainLeft;
+            right[i] += input[i] * gainRight;
+        }
+    }
+
+    void AudioMixer::toPcm16(const float* left, const float* right, int count, int16_t* output) {
+        int i = 0;
+#if defined(AUDIO_MIXER_SSE)
+        // packs satura a [-32768, 32767]: una mezcla que se pasa no da la vuelta.
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 4 <= count; i += 4) {
+            __m128 l = _mm_mul_ps(_mm_load_ps(left + i), scale);
+            __m128 r = _mm_mul_ps(_mm_load_ps(right + i), scale);
+            __m128i low = _mm_cvtps_epi32(_mm_unpacklo_ps(l, r));
+            __m128i high = _mm_cvtps_epi32(_mm_unpackhi_ps(l, r));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2 * i), _mm_packs_epi32(low, high));
+        }
+#endif
+        for (; i < count; i++) {
+            float l = std::min(std::max(left[i], -1.0f), 1.0f);
+            float r = std::min(std::max(right[i], -1.0f), 1.0f);
+            output[2 * i] = static_cast<int16_t>(std::lrint(l * 32767.0f));
+            output[2 * i + 1] = static_cast<int16_t>(std::lrint(r * 32767.0f));
+        }
+    }
+
+}
\ No newline at end of file
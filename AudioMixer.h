@@ -0,0 +1,145 @@
+#ifndef __AUDIO_MIXER_H__
+#define __AUDIO_MIXER_H__
+
+#include "cocos2d.h"
+#include "MatchEvents.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace EpicGame {
+
+    // Efectos de sonido con latencia baja. Las muestras se decodifican a PCM
+    // float al cargar (WAV de Resources/sfx o, si no estan, generadas). El
+    // juego solo empuja ordenes a una cola sin bloqueos; un hilo propio
+    // mezcla bloques de BLOCK_FRAMES con SSE y los encola en una fuente de
+    // OpenAL. En ese hilo no se reserva memoria ni se toma ningun cerrojo
+    // nuestro.
+    //
+    // Objetivo: TARGET_LATENCY_MS desde el paso del juego que lanza el sonido
+    // hasta la salida. La cola de la fuente es de TARGET_LATENCY_MS menos un
+    // bloque (lo que puede tardar el hilo en recoger la orden). OpenAL mezcla
+    // de periodo en periodo del dispositivo, asi que se piden periodos de
+    // 1/DEVICE_REFRESH s con ALC_REFRESH; si el dispositivo da periodos mas
+    // largos, la cola crece a dos periodos para no vaciarse y se avisa de que
+    // no se llega al objetivo.
+    //
+    // Cada orden lleva la hora del paso que la lanzo. Al mezclar su primer
+    // bloque se mide cuanto le queda por delante en la cola de la fuente y,
+    // con AL_SOFT_source_latency, la latencia del dispositivo; shutdown()
+    // escribe p50, p99 y maximo de paso a salida.
+    //
+    // El contexto de OpenAL es del hilo de mezcla con alcSetThreadContext
+    // (ALC_EXT_thread_local_context). Sin la extension se hace actual una
+    // sola vez desde init() y el hilo de mezcla no lo toca.
+    class AudioMixer {
+    public:
+        enum Sound {
+            HIT,
+            SERVE,
+            BOUNCE,
+            FAULT,
+            CHEER,
+            SOUND_COUNT
+        };
+
+        static const int SAMPLE_RATE = 48000;
+        static const int TARGET_LATENCY_MS = 5;
+        static const int BLOCK_FRAMES = 48;         // 1 ms
+        static const int DEVICE_REFRESH = 500;      // periodos/s que se piden (96 frames)
+        static const int DEFAULT_PERIOD_FRAMES = 1024;  // si el dispositivo no dice su periodo
+        static const int MAX_QUEUED_BLOCKS = 192;   // dos periodos de 4096 frames
+        static const int MAX_VOICES = 32;
+        static const int POLL_MICROSECONDS = 250;
+        static constexpr double LATENCY_BIN_MS = 0.25;
+        static const int LATENCY_BINS = 400;        // hasta 100 ms
+
+        static AudioMixer* getInstance();
+
+        // Carga las muestras, abre el dispositivo y arranca el hilo.
+        bool init();
+        void shutdown();
+        bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+        // Reloj de las ordenes, en segundos.
+        static double getTime();
+
+        // Desde el hilo de juego. gain en [0, 1], pan en [-1, 1] (izquierda a
+        // derecha). stepTime es getTime() al empezar el paso que lanza el
+        // sonido; sin el se mide desde la llamada.
+        void play(Sound sound, float gain = 1.0f, float pan = 0.0f, double stepTime = 0.0);
+        // Sonido de un evento del partido; x en [0, width] da el pan.
+        void playEvent(const MatchEvent& event, float width, double stepTime = 0.0);
+
+        int getQueuedBlocks() const { return queuedBlocks; }
+        float getMaxLatencyMs() const { return maxLatencyMicros.load(std::memory_order_relaxed) / 1000.0f; }
+        uint32_t getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+        uint32_t getDroppedCommands() const { return droppedCommands.load(std::memory_order_relaxed); }
+
+    private:
+        struct Command {
+            Sound sound = HIT;
+            float gain = 1.0f;
+            float pan = 0.0f;
+            double stepTime = 0.0;
+        };
+
+        struct Voice {
+            const float* data = nullptr;
+            int length = 0;
+            int position = 0;
+            float gainLeft = 0.0f;
+            float gainRight = 0.0f;
+            double triggerTime = 0.0;
+            bool started = false;
+        };
+
+        AudioMixer() = default;
+        ~AudioMixer();
+
+        void loadSamples();
+        bool decodeWav(const std::string& path, std::vector<float>& pcm) const;
+        void synthesize(Sound sound, std::vector<float>& pcm) const;
+        bool openDevice();
+        void closeDevice();
+        bool setThreadContext(bool current);
+        double measureOutputDelay();
+        double latencyPercentileMs(double percentile) const;
+
+        void mixerLoop();
+        void takeCommands();
+        void mixBlock(int16_t* output);
+        static void mixVoice(const float* input, int count, float gainLeft, float gainRight, float* left, float* right);
+        static void toPcm16(const float* left, const float* right, int count, int16_t* output);
+
+        std::vector<float> samples[SOUND_COUNT];
+
+        SpscRing<Command, 256> commands;
+        std::thread thread;
+        std::atomic<bool> running{ false };
+        std::atomic<uint32_t> maxLatencyMicros{ 0 };
+        std::atomic<uint32_t> underruns{ 0 };
+        std::atomic<uint32_t> droppedCommands{ 0 };
+
+        // Solo hilo de mezcla.
+        Voice voices[MAX_VOICES];
+        alignas(16) float mixLeft[BLOCK_FRAMES];
+        alignas(16) float mixRight[BLOCK_FRAMES];
+        alignas(16) int16_t blockPcm[BLOCK_FRAMES * 2];
+        // Se leen en shutdown(), con el hilo ya parado.
+        uint32_t latencyBins[LATENCY_BINS] = {};
+        uint32_t latencyCount = 0;
+
+        void* device = nullptr;
+        void* context = nullptr;
+        void* threadContextFunction = nullptr;     // alcSetThreadContext
+        void* sourceLatencyFunction = nullptr;     // alGetSourcedvSOFT
+        unsigned int source = 0;
+        unsigned int buffers[MAX_QUEUED_BLOCKS] = {};
+        int queuedBlocks = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "BallFlight.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace EpicGame {
+
+    template <typename T>
+    CourtGeometryT<T> CourtGeometryT<T>::fromVisibleSize(T width, T height) {
+        CourtGeometryT<T> court;
+        court.width = width;
+        court.height = height;
+        court.courtWidth = width * T(0.8f);
+        court.courtHeight = height * T(0.75f);
+        court.baselineOffset = height * T(0.1f);
+        return court;
+    }
+
+    template <typename T>
+    void BallFlight::integrate(BallStateT<T>& ball, T delta) {
+        ball.vy -= T(GRAVITY) * delta * T(GRAVITY_FACTOR);
+        ball.vx *= T(AIR_RESISTANCE);
+        ball.x += ball.vx * delta;
+        ball.y += ball.vy * delta;
+    }
+
+#if defined(__SSE4_1__)
+    // Producto Q16.16 de 4 carriles: productos de 64 bits en pares y se
+    // quedan los bits 16..47, igual que Fixed::operator*.
+    static inline __m128i multiplyFixed(__m128i a, __m128i b) {
+        __m128i even = _mm_srli_epi64(_mm_mul_epi32(a, b), Fixed::FRACTION_BITS);
+        __m128i odd = _mm_srli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)),
+            Fixed::FRACTION_BITS);
+        return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+    }
+#endif
+
+    void BallFlight::integrateBatch(int32_t* x, int32_t* y, int32_t* vx, int32_t* vy,
+        const uint8_t* alive, int count, Fixed delta) {
+        // Mismas operaciones y en el mismo orden que integrate<Fixed>.
+        const Fixed gravityStep = Fixed(GRAVITY) * delta * Fixed(GRAVITY_FACTOR);
+        const Fixed airResistance = Fixed(AIR_RESISTANCE);
+        int i = 0;
+
+#if defined(__SSE4_1__)
+        const __m128i gravityLane = _mm_set1_epi32(gravityStep.raw);
+        const __m128i airLane = _mm_set1_epi32(airResistance.raw);
+        const __m128i deltaLane = _mm_set1_epi32(delta.raw);
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4) {
+            int32_t aliveBytes;
+            memcpy(&aliveBytes, alive + i, sizeof(aliveBytes));
+            __m128i mask = _mm_cmpgt_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(aliveBytes)), zero);
+
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128i py = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+            __m128i pvx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vx + i));
+            __m128i pvy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vy + i));
+
+            __m128i nvy = _mm_sub_epi32(pvy, gravityLane);
+            __m128i nvx = multiplyFixed(pvx, airLane);
+            __m128i nx = _mm_add_epi32(px, multiplyFixed(nvx, deltaLane));
+            __m128i ny = _mm_add_epi32(py, multiplyFixed(nvy, deltaLane));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x + i), _mm_blendv_epi8(px, nx, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i), _mm_blendv_epi8(py, ny, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vx + i), _mm_blendv_epi8(pvx, nvx, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vy + i), _mm_blendv_epi8(pvy, nvy, mask));
+        }
+#endif
+
+        for (; i < count; i++) {
+            if (!alive[i]) {
+                continue;
+            }
+            Fixed newVx = Fixed::fromRaw(vx[i]) * airResistance;
+            Fixed newVy = Fixed::fromRaw(vy[i]) - gravityStep;
+            x[i] = (Fixed::fromRaw(x[i]) + newVx * delta).raw;
+            y[i] = (Fixed::fromRaw(y[i]) + newVy * delta).raw;
+            vx[i] = newVx.raw;
+            vy[i] = newVy.raw;
+        }
+    }
+
+    template <typename T>
+    FlightResult BallFlight::step(BallStateT<T>& ball, T delta, const CourtGeometryT<T>& court, bool& player1Won) {
+        T startX = ball.x;
+        T startY = ball.y;
+        integrate(ball, delta);
+        return resolve(ball, startX, startY, court, player1Won);
+    }
+
+    template <typename T>
+    FlightResult BallFlight::resolve(BallStateT<T>& ball, T startX, T startY, const CourtGeometryT<T>& court,
+        bool& player1Won) {
+        T netY = court.height * T(0.5f);
+        T netThickness = court.height * T(0.02f);
+
+        FlightResult result = FlightResult::IN_PLAY;
+        if (startY >= netY - netThickness &&
+            startY <= netY + netThickness &&
+            scalarAbs(startX - court.width * T(0.5f)) < T(10.0f)) {
+
+            player1Won = ball.vy > T(0.0f);
+            result = FlightResult::NET;
+        }
+        else if (ball.y < court.height * T(0.05f) || ball.y > court.height * T(0.95f)) {
+            player1Won = ball.y < court.height * T(0.5f);
+            result = FlightResult::OUT_LONG;
+        }
+        else if (ball.x < court.width * T(0.1f) || ball.x > court.width * T(0.9f)) {
+            player1Won = ball.y > court.height * T(0.5f);
+            result = FlightResult::OUT_WIDE;
+        }
+        else if (scalarLength(ball.vx, ball.vy) < T(MIN_SPEED)) {
+            player1Won = startY < court.height * T(0.5f);
+            result = FlightResult::DEAD;
+        }
+
+        // Si el punto acaba la pelota se queda donde estaba antes del paso.
+        if (result != FlightResult::IN_PLAY) {
+            ball.x = startX;
+            ball.y = startY;
+        }
+        return result;
+    }
+
+    template <typename T>
+    bool BallFlight::isOutOfCourt(const BallStateT<T>& ball, const CourtGeometryT<T>& court) {
+        T perspectiveScale = getPerspectiveScale(ball.y, court);
+        T leftBoundary = (court.width - court.courtWidth) / T(2) +
+            (T(1.0f) - perspectiveScale) * T(20.0f);
+        T rightBoundary = (court.width + court.courtWidth) / T(2) -
+            (T(1.0f) - perspectiveScale) * T(20.0f);
+
+        return ball.x < leftBoundary ||
+            ball.x > rightBoundary ||
+            ball.y < court.baselineOffset ||
+            ball.y > court.height - court.baselineOffset;
+    }
+
+    template <typename T>
+    T BallFlight::getPerspectiveScale(T yPos, const CourtGeometryT<T>& court) {
+        return T(BACK_PLAYER_SCALE) + (T(FRONT_PLAYER_SCALE) - T(BACK_PLAYER_SCALE)) * (yPos / court.courtHeight);
+    }
+
+    template struct CourtGeometryT<float>;
+    template struct CourtGeometryT<Fixed>;
+    template void BallFlight::integrate<float>(BallStateT<float>&, float);
+    template void BallFlight::integrate<Fixed>(BallStateT<Fixed>&, Fixed);
+    template FlightResult BallFlight::step<float>(BallStateT<float>&, float, const CourtGeometryT<float>&, bool&);
+    template FlightResult BallFlight::step<Fixed>(BallStateT<Fixed>&, Fixed, const CourtGeometryT<Fixed>&, bool&);
+    template FlightResult BallFlight::resolve<float>(BallStateT<float>&, float, float, const CourtGeometryT<float>&, bool&);
+    template FlightResult BallFlight::resolve<Fixed>(BallStateT<Fixed>&, Fixed, Fixed, const CourtGeometryT<Fixed>&, bool&);
+    template bool BallFlight::isOutOfCourt<float>(const BallStateT<float>&, const CourtGeometryT<float>&);
+    template bool BallFlight::isOutOfCourt<Fixed>(const BallStateT<Fixed>&, const CourtGeometryT<Fixed>&);
+    template float BallFlight::getPerspectiveScale<float>(float, const CourtGeometryT<float>&);
+    template Fixed BallFlight::getPerspectiveScale<Fixed>(Fixed, const CourtGeometryT<Fixed>&);
+
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef __BALL_FLIGHT_H__
+#define __BALL_FLIGHT_H__
+
+#include "FixedPoint.h"
+#include <cstdint>
+
+namespace EpicGame {
+
+    // Fisica de la pelota sin dependencias de cocos2d, compartida por
+    // TennisScene y las herramientas que simulan partidos sin ventana.
+    // Las plantillas se instancian para float y para Fixed (Q16.16).
+    template <typename T>
+    struct BallStateT {
+        T x = 0.0f;
+        T y = 0.0f;
+        T vx = 0.0f;
+        T vy = 0.0f;
+    };
+
+    template <typename T>
+    struct CourtGeometryT {
+        T width = 0.0f;
+        T height = 0.0f;
+        T courtWidth = 0.0f;
+        T courtHeight = 0.0f;
+        T baselineOffset = 0.0f;
+
+        static CourtGeometryT fromVisibleSize(T width, T height);
+    };
+
+    typedef BallStateT<float> BallState;
+    typedef CourtGeometryT<float> CourtGeometry;
+
+    enum class FlightResult {
+        IN_PLAY,
+        NET,
+        OUT_LONG,
+        OUT_WIDE,
+        DEAD
+    };
+
+    class BallFlight {
+    public:
+        static constexpr float GRAVITY = -900.0f;
+        static constexpr float GRAVITY_FACTOR = 0.15f;
+        static constexpr float AIR_RESISTANCE = 0.997f;
+        static constexpr float MIN_SPEED = 100.0f;
+        static constexpr float BACK_PLAYER_SCALE = 0.18f;
+        static constexpr float FRONT_PLAYER_SCALE = 0.4f;
+
+        // Solo gravedad, rozamiento y desplazamiento, sin comprobar lineas ni red.
+        template <typename T>
+        static void integrate(BallStateT<T>& ball, T delta);
+
+        // integrate() para muchas pelotas Q16.16 guardadas por columnas (valores
+        // raw). Solo avanza las que tienen alive != 0. Con SSE4.1 procesa 4
+        // pelotas por instruccion y da exactamente lo mismo que integrate<Fixed>.
+        static void integrateBatch(int32_t* x, int32_t* y, int32_t* vx, int32_t* vy,
+            const uint8_t* alive, int count, Fixed delta);
+
+        // Avanza la pelota un paso. La posicion solo se actualiza si la pelota
+        // sigue en juego; player1Won indica el ganador del punto en otro caso.
+        template <typename T>
+        static FlightResult step(BallStateT<T>& ball, T delta, const CourtGeometryT<T>& court, bool& player1Won);
+        // Segunda mitad de step(): la pelota ya se ha integrado desde
+        // (startX, startY) y aqui se miran red, lineas y velocidad. Permite
+        // integrar muchas pelotas con integrateBatch y juzgarlas despues.
+        template <typename T>
+        static FlightResult resolve(BallStateT<T>& ball, T startX, T startY, const CourtGeometryT<T>& court,
+            bool& player1Won);
+
+        template <typename T>
+        static bool isOutOfCourt(const BallStateT<T>& ball, const CourtGeometryT<T>& court);
+        template <typename T>
+        static T getPerspectiveScale(T yPos, const CourtGeometryT<T>& court);
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "BallPool.h"
+
+namespace EpicGame {
+
+    BallPool::BallPool(int capacity)
+        : x(capacity), y(capacity), vx(capacity), vy(capacity),
+        alive(capacity, 0), lastHitter(capacity, 0) {
+        freeSlots.reserve(capacity);
+        releaseAll();
+    }
+
+    int BallPool::spawn(float posX, float posY, float velX, float velY, uint8_t hitter) {
+        if (freeSlots.empty()) {
+            return -1;
+        }
+
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        x[slot] = posX;
+        y[slot] = posY;
+        vx[slot] = velX;
+        vy[slot] = velY;
+        alive[slot] = 1;
+        lastHitter[slot] = hitter;
+        return slot;
+    }
+
+    void BallPool::release(int slot) {
+        if (!alive[slot]) {
+            return;
+        }
+        alive[slot] = 0;
+        freeSlots.push_back(slot);
+    }
+
+    void BallPool::releaseAll() {
+        freeSlots.clear();
+        for (int slot = getCapacity() - 1; slot >= 0; slot--) {
+            alive[slot] = 0;
+            freeSlots.push_back(slot);
+        }
+    }
+
+}
\ No newline at end of file
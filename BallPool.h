@@ -0,0 +1,36 @@
+#ifndef __BALL_POOL_H__
+#define __BALL_POOL_H__
+
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    // Huecos de fisica de capacidad fija para muchas pelotas a la vez. Nada se
+    // reserva despues del constructor: spawn/release solo mueven indices.
+    class BallPool {
+    public:
+        explicit BallPool(int capacity);
+
+        // Devuelve el hueco usado o -1 si el pool esta lleno.
+        int spawn(float x, float y, float vx, float vy, uint8_t hitter);
+        void release(int slot);
+        void releaseAll();
+
+        int getCapacity() const { return static_cast<int>(alive.size()); }
+        int getActiveCount() const { return getCapacity() - static_cast<int>(freeSlots.size()); }
+
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> vx;
+        std::vector<float> vy;
+        std::vector<uint8_t> alive;
+        std::vector<uint8_t> lastHitter;   // 0 = maquina, 1 = jugador
+
+    private:
+        std::vector<int> freeSlots;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "BounceHeatmap.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace EpicGame {
+
+    static const char HEATMAP_MAGIC[4] = { 'H', 'M', 'P', '1' };
+    static const int REDUCE_GRAIN_ROWS = 4;
+
+    BounceHeatmap::BounceHeatmap() : bins(BINS_X * BINS_Y, 0) {
+    }
+
+    void BounceHeatmap::clear() {
+        std::fill(bins.begin(), bins.end(), 0u);
+        total = 0;
+    }
+
+    void BounceHeatmap::merge(const BounceHeatmap& other) {
+        for (size_t i = 0; i < bins.size(); i++) {
+            bins[i] += other.bins[i];
+        }
+        total += other.total;
+    }
+
+    void BounceHeatmap::reduce(const std::vector<const BounceHeatmap*>& parts, BounceHeatmap& result, ThreadPool* pool) {
+        auto body = [&parts, &result](int beginRow, int endRow) {
+            uint32_t* out = result.bins.data() + beginRow * BINS_X;
+            size_t count = static_cast<size_t>(endRow - beginRow) * BINS_X;
+            for (const BounceHeatmap* part : parts) {
+                const uint32_t* in = part->bins.data() + beginRow * BINS_X;
+                for (size_t i = 0; i < count; i++) {
+                    out[i] += in[i];
+                }
+            }
+        };
+
+        if (pool) {
+            pool->parallelFor(BINS_Y, REDUCE_GRAIN_ROWS, body);
+        }
+        else {
+            body(0, BINS_Y);
+        }
+
+        for (const BounceHeatmap* part : parts) {
+            result.total += part->total;
+        }
+    }
+
+    uint32_t BounceHeatmap::getMaxCount() const {
+        uint32_t maxCount = 0;
+        for (uint32_t count : bins) {
+            maxCount = count > maxCount ? count : maxCount;
+        }
+        return maxCount;
+    }
+
+    void BounceHeatmap::toRGBA(std::vector<uint8_t>& pixels) const {
+        pixels.assign(static_cast<size_t>(BINS_X) * BINS_Y * 4, 0);
+        uint32_t maxCount = getMaxCount();
+        if (maxCount == 0) {
+            return;
+        }
+
+        float scale = 1.0f / std::log(1.0f + maxCount);
+        for (int y = 0; y < BINS_Y; y++) {
+            // v = 0 es el fondo de la pantalla; en la textura va abajo.
+            uint8_t* row = pixels.data() + static_cast<size_t>(BINS_Y - 1 - y) * BINS_X * 4;
+            for (int x = 0; x < BINS_X; x++) {
+                uint32_t count = bins[y * BINS_X + x];
+                if (count == 0) {
+                    continue;
+                }
+                float heat = std::log(1.0f + count) * scale;
+                uint8_t* pixel = row + x * 4;
+                pixel[0] = 255;
+                pixel[1] = static_cast<uint8_t>(255.0f * (1.0f - heat));
+                pixel[2] = 0;
+                pixel[3] = static_cast<uint8_t>(60.0f + 160.0f * heat);
+            }
+        }
+    }
+
+    bool BounceHeatmap::save(const std::string& path) const {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+
+        uint32_t size[2] = { static_cast<uint32_t>(BINS_X), static_cast<uint32_t>(BINS_Y) };
+        fwrite(HEATMAP_MAGIC, 1, sizeof(HEATMAP_MAGIC), file);
+        fwrite(size, sizeof(size), 1, file);
+        fwrite(&total, sizeof(total), 1, file);
+        fwrite(bins.data(), sizeof(uint32_t), bins.size(), file);
+
+        bool ok = ferror(file) == 0;
+        fclose(file);
+        return ok;
+    }
+
+    bool BounceHeatmap::load(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        char magic[4];
+        uint32_t size[2] = { 0, 0 };
+        bool ok = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+            memcmp(magic, HEATMAP_MAGIC, sizeof(magic)) == 0 &&
+            fread(size, sizeof(size), 1, file) == 1 && size[0] == BINS_X && size[1] == BINS_Y &&
+            fread(&total, sizeof(total), 1, file) == 1 &&
+            fread(bins.data(), sizeof(uint32_t), bins.size(), file) == bins.size();
+
+        fclose(file);
+        if (!ok) {
+            clear();
+        }
+        return ok;
+    }
+
+}
\ No newline at end of file
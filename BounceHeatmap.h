@@ -0,0 +1,57 @@
+#ifndef __BOUNCE_HEATMAP_H__
+#define __BOUNCE_HEATMAP_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    class ThreadPool;
+
+    // Histograma 2D de donde muere la pelota (eventos BOUNCE: botes sin
+    // fuerza y fueras). Las coordenadas van normalizadas a [0, 1] sobre toda
+    // la pantalla, no solo la pista, para que entren tambien los fuera; asi
+    // vale igual para MatchSim (1280x720) que para la escena.
+    class BounceHeatmap {
+    public:
+        static constexpr int BINS_X = 128;
+        static constexpr int BINS_Y = 72;
+
+        BounceHeatmap();
+
+        void add(float u, float v) {
+            int x = static_cast<int>(u * BINS_X);
+            int y = static_cast<int>(v * BINS_Y);
+            x = x < 0 ? 0 : (x >= BINS_X ? BINS_X - 1 : x);
+            y = y < 0 ? 0 : (y >= BINS_Y ? BINS_Y - 1 : y);
+            bins[y * BINS_X + x]++;
+            total++;
+        }
+
+        void clear();
+        void merge(const BounceHeatmap& other);
+
+        // Suma parts en result. Con pool, cada hilo suma un bloque de filas
+        // de todos los parciales, sin bloqueos ni copias intermedias.
+        static void reduce(const std::vector<const BounceHeatmap*>& parts, BounceHeatmap& result, ThreadPool* pool);
+
+        uint32_t getCount(int x, int y) const { return bins[y * BINS_X + x]; }
+        uint32_t getMaxCount() const;
+        uint64_t getTotal() const { return total; }
+
+        // BINS_X * BINS_Y pixeles RGBA8888, fila 0 arriba como espera
+        // Texture2D. Escala logaritmica: de transparente a amarillo y rojo.
+        void toRGBA(std::vector<uint8_t>& pixels) const;
+
+        bool save(const std::string& path) const;
+        bool load(const std::string& path);
+
+    private:
+        std::vector<uint32_t> bins;
+        uint64_t total = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
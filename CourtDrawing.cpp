@@ -0,0 +1,81 @@
+#include "CourtDrawing.h"
+#include "TennisRules.h"
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        const Color4F SURROUND_COLOR(0.16f, 0.42f, 0.28f, 1.0f);
+        const Color4F SURFACE_COLOR(0.20f, 0.36f, 0.62f, 1.0f);
+        const Color4F LINE_COLOR(0.95f, 0.95f, 0.95f, 1.0f);
+        const Color4F NET_COLOR(0.10f, 0.10f, 0.12f, 0.85f);
+
+    }
+
+    float CourtDrawing::getSidelineX(const CourtGeometry& court, float y, bool right) {
+        float inset = (1.0f - BallFlight::getPerspectiveScale(y, court)) * 20.0f;
+        return right ? (court.width + court.courtWidth) / 2 - inset : (court.width - court.courtWidth) / 2 + inset;
+    }
+
+    DrawNode* CourtDrawing::create(const CourtGeometry& court, float netHeight) {
+        auto node = DrawNode::create();
+        if (!node) {
+            return nullptr;
+        }
+
+        float bottom = court.baselineOffset;
+        float top = court.height - court.baselineOffset;
+        float netY = court.height * 0.5f;
+        float centerX = court.width * 0.5f;
+        float lineRadius = court.height * 0.002f;
+
+        node->drawSolidRect(Vec2(0, 0), Vec2(court.width, court.height), SURROUND_COLOR);
+
+        Vec2 surface[4] = {
+            Vec2(getSidelineX(court, bottom, false), bottom),
+            Vec2(getSidelineX(court, bottom, true), bottom),
+            Vec2(getSidelineX(court, top, true), top),
+            Vec2(getSidelineX(court, top, false), top)
+        };
+        node->drawSolidPoly(surface, 4, SURFACE_COLOR);
+
+        // Fondo y laterales: los mismos limites que BallFlight::isOutOfCourt.
+        for (int i = 0; i < 4; i++) {
+            node->drawSegment(surface[i], surface[(i + 1) % 4], lineRadius, LINE_COLOR);
+        }
+
+        // Cajas de saque: rectangulos en pantalla, sin perspectiva, igual que
+        // los comprueba isInServiceBox. La linea central las parte en dos.
+        float boxLeft = centerX - court.width * MatchScore::SERVICE_BOX_HALF_WIDTH;
+        float boxRight = centerX + court.width * MatchScore::SERVICE_BOX_HALF_WIDTH;
+        float boxFront = court.height * MatchScore::SERVICE_BOX_FRONT;
+        float boxBack = court.height * MatchScore::SERVICE_BOX_BACK;
+        for (int half = 0; half < 2; half++) {
+            float front = half == 0 ? boxFront : court.height - boxFront;
+            float back = half == 0 ? boxBack : court.height - boxBack;
+            Vec2 box[4] = { Vec2(boxLeft, back), Vec2(boxRight, back), Vec2(boxRight, front), Vec2(boxLeft, front) };
+            for (int i = 0; i < 4; i++) {
+                node->drawSegment(box[i], box[(i + 1) % 4], lineRadius, LINE_COLOR);
+            }
+            node->drawSegment(Vec2(centerX, back), Vec2(centerX, front), lineRadius, LINE_COLOR);
+        }
+
+        // Marcas centrales de los fondos.
+        float markLength = court.height * 0.015f;
+        node->drawSegment(Vec2(centerX, bottom), Vec2(centerX, bottom + markLength), lineRadius, LINE_COLOR);
+        node->drawSegment(Vec2(centerX, top), Vec2(centerX, top - markLength), lineRadius, LINE_COLOR);
+
+        // Red de lado a lado con la cinta blanca arriba y los postes fuera de la pista.
+        float netLeft = getSidelineX(court, netY, false) - lineRadius * 6;
+        float netRight = getSidelineX(court, netY, true) + lineRadius * 6;
+        node->drawSolidRect(Vec2(netLeft, netY - netHeight / 2), Vec2(netRight, netY + netHeight / 2), NET_COLOR);
+        node->drawSegment(Vec2(netLeft, netY + netHeight / 2), Vec2(netRight, netY + netHeight / 2), lineRadius, LINE_COLOR);
+        node->drawSolidCircle(Vec2(netLeft, netY), lineRadius * 4, 0.0f, 8, LINE_COLOR);
+        node->drawSolidCircle(Vec2(netRight, netY), lineRadius * 4, 0.0f, 8, LINE_COLOR);
+
+        return node;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef __COURT_DRAWING_H__
+#define __COURT_DRAWING_H__
+
+#include "cocos2d.h"
+#include "BallFlight.h"
+
+namespace EpicGame {
+
+    // Pista generada con geometria en vez de court.png: fondo, superficie,
+    // lineas y red en un solo DrawNode (un buffer de vertices, un draw call).
+    // Las bandas usan BallFlight::getPerspectiveScale igual que isOutOfCourt
+    // y las cajas de saque las constantes de MatchScore::isInServiceBox, asi
+    // que lo que se ve es exactamente lo que cuenta como dentro, y se ve
+    // nitido a cualquier resolucion sin cargar texturas.
+    class CourtDrawing {
+    public:
+        static cocos2d::DrawNode* create(const CourtGeometry& court, float netHeight);
+
+        // Borde izquierdo o derecho de la pista a la altura y.
+        static float getSidelineX(const CourtGeometry& court, float y, bool right);
+    };
+
+}
+
+#endif
\ No newline at end of file
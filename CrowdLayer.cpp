@@ -0,0 +1,237 @@
+#include "CrowdLayer.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    CrowdLayer* CrowdLayer::create(const std::vector<Rect>& stands, int spectatorCount, uint32_t seed) {
+        auto layer = new (std::nothrow) CrowdLayer();
+        if (layer && layer->init(stands, spectatorCount, seed)) {
+            layer->autorelease();
+            return layer;
+        }
+        delete layer;
+        return nullptr;
+    }
+
+    CrowdLayer::~CrowdLayer() {
+        for (TextureAtlas* atlas : atlases) {
+            atlas->release();
+        }
+        CC_SAFE_RELEASE(texture);
+    }
+
+    bool CrowdLayer::init(const std::vector<Rect>& stands, int spectatorCount, uint32_t seed) {
+        if (!Node::init() || stands.empty()) {
+            return false;
+        }
+        if (!initTexture()) {
+            return false;
+        }
+
+        if (spectatorCount > MAX_SPECTATORS) {
+            CCLOG("Aviso: %d espectadores, solo caben %d", spectatorCount, MAX_SPECTATORS);
+        }
+        count = std::min(std::max(spectatorCount, 0), MAX_SPECTATORS);
+        for (int first = 0; first < count; first += ATLAS_SIZE) {
+            TextureAtlas* atlas = TextureAtlas::createWithTexture(texture, std::min(count - first, ATLAS_SIZE));
+            if (!atlas) {
+                CCLOG("Error: No se pudo crear el atlas del publico");
+                return false;
+            }
+            atlas->retain();
+            atlases.push_back(atlas);
+        }
+        drawCommands.resize(atlases.size());
+        setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR));
+
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+        spectatorHeight = visibleSize.height * 0.02f;
+        spectatorWidth = spectatorHeight * FRAME_WIDTH / FRAME_HEIGHT;
+
+        // Cada grada recibe espectadores segun su area.
+        float totalArea = 0.0f;
+        for (const Rect& stand : stands) {
+            totalArea += stand.size.width * stand.size.height;
+        }
+
+        std::minstd_rand rng(seed % 2147483646u + 1u);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<Vec2> positions;
+        positions.reserve(count);
+        for (size_t i = 0; i < stands.size(); i++) {
+            const Rect& stand = stands[i];
+            int standCount = i + 1 == stands.size() ? count - static_cast<int>(positions.size()) :
+                static_cast<int>(count * stand.size.width * stand.size.height / totalArea);
+            for (int j = 0; j < standCount; j++) {
+                positions.push_back(Vec2(stand.origin.x + unit(rng) * stand.size.width,
+                    stand.origin.y + unit(rng) * stand.size.height));
+            }
+        }
+        // De atras hacia delante: los de abajo tapan a los de arriba.
+        std::sort(positions.begin(), positions.end(), [](const Vec2& a, const Vec2& b) { return a.y > b.y; });
+
+        static const Color3B SHIRTS[] = {
+            Color3B(230, 230, 230), Color3B(60, 60, 70), Color3B(200, 170, 60), Color3B(90, 140, 80)
+        };
+        static const Color3B TEAM_SHIRTS[] = { Color3B(50, 90, 210), Color3B(210, 50, 50) };
+
+        baseY.resize(count);
+        phase.resize(count);
+        rate.resize(count);
+        team.resize(count);
+        jitter.resize(count);
+        delay.assign(count, 0.0f);
+        support.assign(count, 0.0f);
+
+        V3F_C4B_T2F_Quad quad;
+        for (int i = 0; i < count; i++) {
+            baseY[i] = positions[i].y;
+            phase[i] = unit(rng);
+            rate[i] = 0.8f + 0.4f * unit(rng);
+            jitter[i] = 0.3f * unit(rng);
+
+            int side = static_cast<int>(unit(rng) * 3.0f);
+            team[i] = static_cast<float>(side);
+            Color3B shirt = side == 0 ? SHIRTS[static_cast<int>(unit(rng) * 4.0f) & 3] : TEAM_SHIRTS[side - 1];
+            Color4B color(shirt.r, shirt.g, shirt.b, 255);
+
+            float left = positions[i].x - spectatorWidth / 2;
+            float right = positions[i].x + spectatorWidth / 2;
+            quad.tl.vertices = Vec3(left, baseY[i] + spectatorHeight, 0.0f);
+            quad.bl.vertices = Vec3(left, baseY[i], 0.0f);
+            quad.tr.vertices = Vec3(right, baseY[i] + spectatorHeight, 0.0f);
+            quad.br.vertices = Vec3(right, baseY[i], 0.0f);
+            quad.tl.colors = quad.bl.colors = quad.tr.colors = quad.br.colors = color;
+            quad.tl.texCoords = Tex2F(0.0f, 0.0f);
+            quad.bl.texCoords = Tex2F(0.0f, 1.0f);
+            quad.tr.texCoords = Tex2F(1.0f / FRAME_COUNT, 0.0f);
+            quad.br.texCoords = Tex2F(1.0f / FRAME_COUNT, 1.0f);
+            atlases[i / ATLAS_SIZE]->updateQuad(&quad, i % ATLAS_SIZE);
+        }
+
+        scheduleUpdate();
+        return true;
+    }
+
+    bool CrowdLayer::initTexture() {
+        // Siluetas blancas (el color lo pone el vertice); cabeza mas clara que el cuerpo.
+        const int width = FRAME_WIDTH * FRAME_COUNT;
+        std::vector<uint8_t> pixels(width * FRAME_HEIGHT * 4, 0);
+        auto fill = [&](int frame, int x0, int y0, int x1, int y1, uint8_t shade) {
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    uint8_t* pixel = &pixels[(y * width + frame * FRAME_WIDTH + x) * 4];
+                    pixel[0] = pixel[1] = pixel[2] = shade;
+                    pixel[3] = 255;
+                }
+            }
+        };
+
+        for (int frame = 0; frame < FRAME_COUNT; frame++) {
+            int headShift = frame & 1;
+            fill(frame, 2 + headShift, 2, 4 + headShift, 4, 255);
+            fill(frame, 1, 6, 6, 15, 200);
+            if (frame >= 2) {
+                // Brazos arriba; en el frame 3 mas abiertos.
+                int reach = frame == 3 ? 0 : 1;
+                fill(frame, reach, 1 + reach, reach, 7, 200);
+                fill(frame, 7 - reach, 1 + reach, 7 - reach, 7, 200);
+            }
+        }
+
+        texture = new (std::nothrow) Texture2D();
+        if (!texture || !texture->initWithData(pixels.data(), pixels.size(), Texture2D::PixelFormat::RGBA8888,
+            width, FRAME_HEIGHT, Size(width, FRAME_HEIGHT))) {
+            CCLOG("Error: No se pudo crear la textura del publico");
+            CC_SAFE_RELEASE_NULL(texture);
+            return false;
+        }
+        texture->setAliasTexParameters();
+        return true;
+    }
+
+    void CrowdLayer::cheer(int winner) {
+        float winnerTeam = static_cast<float>(winner);
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+        // La ola empieza en el fondo del que gana el punto.
+        float originY = winner == 1 ? 0.0f : visibleSize.height;
+
+        float lastDelay = 0.0f;
+        for (int i = 0; i < count; i++) {
+            delay[i] = jitter[i] + std::abs(baseY[i] - originY) / RIPPLE_SPEED;
+            lastDelay = std::max(lastDelay, delay[i]);
+            float isTeam = team[i] == winnerTeam ? 1.0f : 0.0f;
+            float isNeutral = team[i] == 0.0f ? 1.0f : 0.0f;
+            support[i] = isTeam + isNeutral * NEUTRAL_SUPPORT + (1.0f - isTeam - isNeutral) * RIVAL_SUPPORT;
+        }
+        cheerAge = 0.0f;
+        cheerEnd = lastDelay + CHEER_DURATION;
+    }
+
+    void CrowdLayer::update(float delta) {
+        cheerAge += delta;
+
+        const float age = cheerAge;
+        const float hop = HOP_HEIGHT * spectatorHeight;
+        const float idleStep = IDLE_RATE * delta;
+        const float cheerStep = (CHEER_RATE - IDLE_RATE) * delta;
+        const float invDuration = 1.0f / CHEER_DURATION;
+        const float frameU = 1.0f / FRAME_COUNT;
+        const float height = spectatorHeight;
+
+        for (size_t a = 0; a < atlases.size(); a++) {
+            int first = static_cast<int>(a) * ATLAS_SIZE;
+            int size = std::min(count - first, ATLAS_SIZE);
+            float* phases = phase.data() + first;
+            const float* rates = rate.data() + first;
+            const float* delays = delay.data() + first;
+            const float* supports = support.data() + first;
+            const float* bases = baseY.data() + first;
+            V3F_C4B_T2F_Quad* out = atlases[a]->getQuads();
+
+            for (int i = 0; i < size; i++) {
+                // Entusiasmo: 0 antes de que llegue la ola, 1 al llegar y baja hasta 0.
+                float since = age - delays[i];
+                float excitement = since >= 0.0f ? std::max(0.0f, 1.0f - since * invDuration) * supports[i] : 0.0f;
+
+                float p = phases[i] + rates[i] * (idleStep + cheerStep * excitement);
+                p -= static_cast<float>(static_cast<int>(p));
+                phases[i] = p;
+
+                float bottom = bases[i] + hop * excitement * 4.0f * p * (1.0f - p);
+                float frame = (excitement > 0.1f ? 2.0f : 0.0f) + (p >= 0.5f ? 1.0f : 0.0f);
+                float u0 = frame * frameU;
+                float u1 = u0 + frameU;
+
+                V3F_C4B_T2F_Quad& quad = out[i];
+                quad.bl.vertices.y = quad.br.vertices.y = bottom;
+                quad.tl.vertices.y = quad.tr.vertices.y = bottom + height;
+                quad.tl.texCoords.u = quad.bl.texCoords.u = u0;
+                quad.tr.texCoords.u = quad.br.texCoords.u = u1;
+            }
+        }
+    }
+
+    void CrowdLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags) {
+        // En orden: cada atlas tiene gente mas adelantada que el anterior.
+        for (size_t a = 0; a < atlases.size(); a++) {
+            drawCommands[a].init(_globalZOrder, transform, flags);
+            drawCommands[a].func = CC_CALLBACK_0(CrowdLayer::onDraw, this, static_cast<int>(a), transform, flags);
+            renderer->addCommand(&drawCommands[a]);
+        }
+    }
+
+    void CrowdLayer::onDraw(int atlas, const Mat4& transform, uint32_t flags) {
+        auto glProgram = getGLProgram();
+        glProgram->use();
+        glProgram->setUniformsForBuiltins(transform);
+        GL::blendFunc(BlendFunc::ALPHA_PREMULTIPLIED.src, BlendFunc::ALPHA_PREMULTIPLIED.dst);
+        // drawNumberOfQuads enlaza la textura y sube los quads si han cambiado.
+        atlases[atlas]->drawNumberOfQuads(atlases[atlas]->getCapacity(), 0);
+    }
+
+}
\ No newline at end of file
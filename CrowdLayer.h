@@ -0,0 +1,73 @@
+#ifndef __CROWD_LAYER_H__
+#define __CROWD_LAYER_H__
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    // Publico de las gradas: miles de espectadores sin un Sprite por cabeza.
+    // Cada uno es un quad en TextureAtlas propias (textura de 4 frames
+    // generada al crear la capa, color por vertice) y cada atlas se pinta con
+    // un solo drawNumberOfQuads. El estado va en arrays paralelos y update los
+    // recorre en bucles sin ramas, que el compilador vectoriza.
+    class CrowdLayer : public cocos2d::Node {
+    public:
+        // Los indices de TextureAtlas son de 16 bits: a partir de ATLAS_SIZE
+        // espectadores se reparten en varios atlas, uno por CustomCommand.
+        static const int ATLAS_SIZE = 65536 / 4 - 1;
+        static const int MAX_SPECTATORS = ATLAS_SIZE * 8;
+
+        static CrowdLayer* create(const std::vector<cocos2d::Rect>& stands, int spectatorCount, uint32_t seed);
+        bool init(const std::vector<cocos2d::Rect>& stands, int spectatorCount, uint32_t seed);
+        ~CrowdLayer();
+
+        // winner 1 o 2: sus aficionados saltan mas; la ola sale de su fondo.
+        void cheer(int winner);
+
+        void update(float delta) override;
+        void draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags) override;
+
+        int getSpectatorCount() const { return count; }
+        // La ultima celebracion sigue en marcha en alguna parte de la grada.
+        bool isCheering() const { return cheerAge < cheerEnd; }
+
+    private:
+        static const int FRAME_WIDTH = 8;
+        static const int FRAME_HEIGHT = 16;
+        static const int FRAME_COUNT = 4;   // 0-1 sentado, 2-3 brazos arriba
+
+        const float IDLE_RATE = 0.6f;       // ciclos/s
+        const float CHEER_RATE = 2.5f;
+        const float CHEER_DURATION = 2.5f;
+        const float RIPPLE_SPEED = 900.0f;  // pixeles/s
+        const float HOP_HEIGHT = 0.6f;      // en alturas de espectador
+        const float RIVAL_SUPPORT = 0.25f;
+        const float NEUTRAL_SUPPORT = 0.6f;
+
+        bool initTexture();
+        void onDraw(int atlas, const cocos2d::Mat4& transform, uint32_t flags);
+
+        cocos2d::Texture2D* texture = nullptr;
+        std::vector<cocos2d::TextureAtlas*> atlases;   // ATLAS_SIZE quads cada uno, el ultimo el resto
+        std::vector<cocos2d::CustomCommand> drawCommands;
+        int count = 0;
+        float spectatorWidth = 0.0f;
+        float spectatorHeight = 0.0f;
+
+        std::vector<float> baseY;
+        std::vector<float> phase;       // [0, 1)
+        std::vector<float> rate;        // variacion por espectador del ritmo
+        std::vector<float> team;        // 0 neutral, 1 o 2
+        std::vector<float> jitter;      // retraso propio al empezar a celebrar
+        std::vector<float> delay;       // retraso total en la celebracion actual
+        std::vector<float> support;     // cuanto celebra la celebracion actual
+
+        float cheerAge = 1000.0f;
+        float cheerEnd = 0.0f;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "EntityStore.h"
+
+namespace EpicGame {
+
+    int EntityStore::createEntity(uint8_t components) {
+        int entity = size();
+        masks.push_back(components);
+        transforms.emplace_back();
+        velocities.emplace_back();
+        controllers.emplace_back();
+        shadowLinks.emplace_back();
+        return entity;
+    }
+
+    void EntityStore::clear() {
+        masks.clear();
+        transforms.clear();
+        velocities.clear();
+        controllers.clear();
+        shadowLinks.clear();
+    }
+
+    void EntityStore::reserve(int count) {
+        masks.reserve(count);
+        transforms.reserve(count);
+        velocities.reserve(count);
+        controllers.reserve(count);
+        shadowLinks.reserve(count);
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef __ENTITY_STORE_H__
+#define __ENTITY_STORE_H__
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    struct Transform {
+        cocos2d::Vec2 position;
+        float scale = 1.0f;
+    };
+
+    struct Velocity {
+        cocos2d::Vec2 value;
+    };
+
+    enum class ControllerType : uint8_t {
+        KEYBOARD,
+        AI
+    };
+
+    struct Controller {
+        ControllerType type = ControllerType::AI;
+        int team = 1;          // 1 = campo de abajo, 2 = campo de arriba
+        float speed = 0.0f;
+    };
+
+    struct ShadowLink {
+        int shadow = -1;
+    };
+
+    // Componentes en arrays contiguos indexados por entidad. Los sistemas de
+    // TennisScene recorren los arrays en vez de tratar cada sprite aparte,
+    // asi que mas jugadores o pelotas no necesitan codigo nuevo.
+    class EntityStore {
+    public:
+        enum Component : uint8_t {
+            TRANSFORM = 1 << 0,
+            VELOCITY = 1 << 1,
+            CONTROLLER = 1 << 2,
+            SHADOW_LINK = 1 << 3
+        };
+
+        int createEntity(uint8_t components);
+        void clear();
+        void reserve(int count);
+
+        int size() const { return static_cast<int>(masks.size()); }
+        bool has(int entity, uint8_t components) const { return (masks[entity] & components) == components; }
+
+        std::vector<uint8_t> masks;
+        std::vector<Transform> transforms;
+        std::vector<Velocity> velocities;
+        std::vector<Controller> controllers;
+        std::vector<ShadowLink> shadowLinks;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef __FIXED_POINT_H__
+#define __FIXED_POINT_H__
+
+#include <cmath>
+#include <cstdint>
+
+namespace EpicGame {
+
+    // Numero Q16.16 (16 bits enteros con signo, 16 de fraccion). Todas las
+    // operaciones son enteras, asi que dan el mismo resultado en cualquier
+    // CPU y compilador. Rango: +-32767, resolucion 1/65536.
+    //
+    // El producto y el cociente se calculan en 64 bits, pero el resultado
+    // vuelve a 32: suma, resta y producto dan la vuelta si se salen del
+    // rango, como int32_t. En MatchSim los valores no pasan de ~1300 px ni
+    // ~1000 px/s y los cuadrados van por scalarLength, en 64 bits. Cualquier
+    // formula nueva cuyo resultado pueda pasar de 32767 tiene que hacer lo
+    // mismo. La division si satura, y dividir por cero da el extremo del
+    // signo del dividendo en vez de abortar.
+    struct Fixed {
+        static constexpr int FRACTION_BITS = 16;
+        static constexpr int32_t ONE = 1 << FRACTION_BITS;
+        static constexpr int32_t RAW_MAX = INT32_MAX;
+        static constexpr int32_t RAW_MIN = INT32_MIN;
+
+        int32_t raw;
+
+        Fixed() = default;
+        // Conversion desde float por truncamiento: escalar por 2^16 es exacto,
+        // asi que el mismo float da siempre el mismo raw.
+        constexpr Fixed(float value) : raw(static_cast<int32_t>(value * static_cast<float>(ONE))) {}
+        constexpr Fixed(int value) : raw(value * ONE) {}
+
+        static constexpr Fixed fromRaw(int32_t value) { return Fixed(value, RawTag()); }
+
+        explicit operator float() const { return static_cast<float>(raw) / static_cast<float>(ONE); }
+        explicit operator double() const { return static_cast<double>(raw) / static_cast<double>(ONE); }
+
+        Fixed operator-() const { return fromRaw(-raw); }
+        Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+        Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+        Fixed& operator*=(Fixed other) { *this = *this * other; return *this; }
+        Fixed& operator/=(Fixed other) { *this = *this / other; return *this; }
+
+        friend Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw + b.raw); }
+        friend Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw - b.raw); }
+        friend Fixed operator*(Fixed a, Fixed b) {
+            return fromRaw(static_cast<int32_t>((static_cast<int64_t>(a.raw) * b.raw) >> FRACTION_BITS));
+        }
+        friend Fixed operator/(Fixed a, Fixed b) {
+            if (b.raw == 0) {
+                return fromRaw(a.raw < 0 ? RAW_MIN : RAW_MAX);
+            }
+            int64_t quotient = (static_cast<int64_t>(a.raw) * ONE) / b.raw;
+            if (quotient > RAW_MAX) {
+                return fromRaw(RAW_MAX);
+            }
+            if (quotient < RAW_MIN) {
+                return fromRaw(RAW_MIN);
+            }
+            return fromRaw(static_cast<int32_t>(quotient));
+        }
+
+        friend bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+        friend bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+        friend bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+        friend bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+        friend bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+        friend bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+    private:
+        struct RawTag {};
+        constexpr Fixed(int32_t value, RawTag) : raw(value) {}
+    };
+
+    // Raiz entera bit a bit de un valor de 64 bits.
+    inline uint64_t integerSqrt(uint64_t value) {
+        uint64_t result = 0;
+        uint64_t bit = 1ull << 62;
+        while (bit > value) {
+            bit >>= 2;
+        }
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+
+    // Escalar de la simulacion sin ventana. Compilando con TENNIS_FIXED_POINT
+    // MatchSim y BallFlight usan Q16.16; por defecto siguen en float.
+#ifdef TENNIS_FIXED_POINT
+    typedef Fixed Scalar;
+#else
+    typedef float Scalar;
+#endif
+
+    inline float toFloat(float value) { return value; }
+    inline float toFloat(Fixed value) { return static_cast<float>(value); }
+
+    inline float scalarAbs(float value) { return std::abs(value); }
+    inline Fixed scalarAbs(Fixed value) { return value.raw < 0 ? -value : value; }
+
+    inline float scalarMin(float a, float b) { return a < b ? a : b; }
+    inline Fixed scalarMin(Fixed a, Fixed b) { return a < b ? a : b; }
+    inline float scalarMax(float a, float b) { return a > b ? a : b; }
+    inline Fixed scalarMax(Fixed a, Fixed b) { return a > b ? a : b; }
+
+    // Modulo de (x, y). En Q16.16 el cuadrado se hace en 64 bits para no
+    // desbordar con velocidades de cientos de pixeles/s.
+    inline float scalarLength(float x, float y) { return std::sqrt(x * x + y * y); }
+    inline Fixed scalarLength(Fixed x, Fixed y) {
+        uint64_t squared = static_cast<uint64_t>(static_cast<int64_t>(x.raw) * x.raw) +
+            static_cast<uint64_t>(static_cast<int64_t>(y.raw) * y.raw);
+        return Fixed::fromRaw(static_cast<int32_t>(integerSqrt(squared)));
+    }
+
+    // sin(pi * t) para t en [0, 1]. En Q16.16 se usa la aproximacion de
+    // Bhaskara (error < 0.2%), que solo necesita operaciones enteras.
+    inline float scalarSinPi(float t) { return std::sin(t * 3.14159265f); }
+    inline Fixed scalarSinPi(Fixed t) {
+        Fixed p = t * (Fixed(1) - t);
+        return Fixed(16) * p / (Fixed(5) - Fixed(4) * p);
+    }
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "FlightRecorder.h"
+#include <cstdio>
+
+namespace EpicGame {
+
+    FlightRecorder::FlightRecorder(size_t frameCapacity) {
+        size_t capacity = 1;
+        while (capacity < frameCapacity) {
+            capacity <<= 1;
+        }
+        frames.resize(capacity, FlightFrame());
+        mask = capacity - 1;
+    }
+
+    bool FlightRecorder::dump(const std::string& path, const std::string& reason) const {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+
+        fprintf(file, "# %s\n", reason.c_str());
+        fprintf(file, "state_hash,frame,delta,ball_x,ball_y,ball_vx,ball_vy,player1_x,player2_x,game_state,serve_state,"
+            "input,fault_count,p1_points,p2_points,p1_games,p2_games,p1_sets,p2_sets,serving,deuce_side\n");
+
+        for (uint64_t i = recorded - size(); i < recorded; i++) {
+            const FlightFrame& f = frames[i & mask];
+            fprintf(file, "%016llx,%u,%.6f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+                static_cast<unsigned long long>(f.stateHash), f.frame, f.delta, f.ballX, f.ballY, f.ballVX, f.ballVY, f.player1X, f.player2X,
+                f.gameState, f.serveState, f.input, f.faultCount,
+                f.player1Points, f.player2Points, f.player1Games, f.player2Games,
+                f.player1Sets, f.player2Sets, f.servingPlayer, f.isDeuceSide);
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    bool FlightRecorder::shouldAutoDump() const {
+        return lastDumpAt == 0 || recorded - lastDumpAt >= frames.size() / 2;
+    }
+
+}
\ No newline at end of file
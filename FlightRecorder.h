@@ -0,0 +1,75 @@
+#ifndef __FLIGHT_RECORDER_H__
+#define __FLIGHT_RECORDER_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    // Estado compacto de un frame: lo justo para reconstruir una jugada.
+    struct FlightFrame {
+        enum InputFlags : uint8_t {
+            INPUT_LEFT = 1 << 0,
+            INPUT_RIGHT = 1 << 1,
+            INPUT_UP = 1 << 2,
+            INPUT_DOWN = 1 << 3,
+            INPUT_SPACE = 1 << 4
+        };
+
+        uint64_t stateHash;     // StateHasher sobre el resto de campos
+        uint32_t frame;
+        float delta;
+        float ballX;
+        float ballY;
+        float ballVX;
+        float ballVY;
+        float player1X;
+        float player2X;
+        uint8_t gameState;
+        uint8_t serveState;
+        uint8_t input;
+        uint8_t faultCount;
+        uint8_t player1Points;
+        uint8_t player2Points;
+        uint8_t player1Games;
+        uint8_t player2Games;
+        uint8_t player1Sets;
+        uint8_t player2Sets;
+        uint8_t servingPlayer;
+        uint8_t isDeuceSide;
+    };
+
+    // Ring de tamano fijo con los ultimos frames. Grabar un frame es rellenar
+    // el hueco que devuelve nextFrame(): sin reservas, sin copias extra y sin
+    // ramas salvo la mascara. Solo se escribe a disco al volcar.
+    class FlightRecorder {
+    public:
+        // frameCapacity se redondea a la siguiente potencia de 2.
+        explicit FlightRecorder(size_t frameCapacity);
+
+        FlightFrame& nextFrame() {
+            return frames[(recorded++) & mask];
+        }
+
+        size_t size() const { return recorded < frames.size() ? static_cast<size_t>(recorded) : frames.size(); }
+        size_t capacity() const { return frames.size(); }
+
+        // Escribe los frames en orden, del mas antiguo al ultimo, como CSV.
+        bool dump(const std::string& path, const std::string& reason) const;
+
+        // Para volcados automaticos: evita repetir si no se ha renovado al
+        // menos la mitad del ring desde el ultimo.
+        bool shouldAutoDump() const;
+        void markDumped() { lastDumpAt = recorded; }
+
+    private:
+        std::vector<FlightFrame> frames;
+        uint64_t mask;
+        uint64_t recorded = 0;
+        uint64_t lastDumpAt = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "FrameEncoder.h"
+#include "cocos2d.h"
+#include <cstdio>
+#include <cstring>
+
+namespace EpicGame {
+
+    FrameEncoder::FrameEncoder(const std::string& directory, Format format, int threadCount)
+        : directory(directory), format(format) {
+        if (threadCount < 1) {
+            threadCount = 1;
+        }
+        for (int i = 0; i < threadCount; i++) {
+            workers.emplace_back(&FrameEncoder::workerLoop, this);
+        }
+    }
+
+    FrameEncoder::~FrameEncoder() {
+        finish();
+    }
+
+    void FrameEncoder::submit(uint32_t frame, const uint8_t* pixels, int width, int height) {
+        size_t size = static_cast<size_t>(width) * height * 4;
+        std::vector<uint8_t> buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceCondition.wait(lock, [this] { return jobs.size() + busyJobs < MAX_PENDING; });
+            if (!freeBuffers.empty()) {
+                buffer.swap(freeBuffers.back());
+                freeBuffers.pop_back();
+            }
+        }
+
+        // La copia se hace fuera del cerrojo; el buffer reciclado ya tiene el tamano.
+        buffer.resize(size);
+        memcpy(buffer.data(), pixels, size);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.emplace_back();
+            Job& job = jobs.back();
+            job.frame = frame;
+            job.width = width;
+            job.height = height;
+            job.pixels.swap(buffer);
+        }
+        workCondition.notify_one();
+    }
+
+    void FrameEncoder::finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+            stopping = true;
+        }
+        workCondition.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    void FrameEncoder::workerLoop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                busyJobs++;
+            }
+
+            if (write(job)) {
+                writtenCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                failedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                busyJobs--;
+                freeBuffers.push_back(std::move(job.pixels));
+            }
+            spaceCondition.notify_one();
+        }
+    }
+
+    bool FrameEncoder::write(const Job& job) const {
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%06u.%s", job.frame, format == Format::PNG ? "png" : "rgba");
+        std::string path = directory + "/" + name;
+
+        if (format == Format::RAW) {
+            FILE* file = fopen(path.c_str(), "wb");
+            if (!file) {
+                return false;
+            }
+            bool ok = fwrite(job.pixels.data(), 1, job.pixels.size(), file) == job.pixels.size();
+            ok = fclose(file) == 0 && ok;
+            return ok;
+        }
+
+        // Image no toca OpenGL: se puede usar fuera del hilo principal.
+        auto image = new (std::nothrow) cocos2d::Image();
+        if (!image) {
+            return false;
+        }
+        bool ok = image->initWithRawData(job.pixels.data(), static_cast<ssize_t>(job.pixels.size()),
+            job.width, job.height, 8, false) && image->saveToFile(path, false);
+        image->release();
+        return ok;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef __FRAME_ENCODER_H__
+#define __FRAME_ENCODER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EpicGame {
+
+    // Escribe frames RGBA a disco (frame_000000.png o .rgba) en varios hilos
+    // para que codificar PNG no frene al que renderiza. Los buffers se
+    // reciclan y la cola tiene tope: si los hilos no dan abasto, submit espera.
+    class FrameEncoder {
+    public:
+        enum class Format {
+            PNG,
+            RAW     // RGBA8888 sin cabecera, filas de arriba abajo
+        };
+
+        static const size_t MAX_PENDING = 16;
+
+        FrameEncoder(const std::string& directory, Format format, int threadCount);
+        ~FrameEncoder();
+        FrameEncoder(const FrameEncoder&) = delete;
+        FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+        // Copia pixels (width * height * 4 bytes, fila 0 arriba) y la encola.
+        void submit(uint32_t frame, const uint8_t* pixels, int width, int height);
+        // Espera a que se escriba todo lo encolado y para los hilos.
+        void finish();
+
+        uint32_t getWrittenCount() const { return writtenCount.load(std::memory_order_relaxed); }
+        uint32_t getFailedCount() const { return failedCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Job {
+            uint32_t frame = 0;
+            int width = 0;
+            int height = 0;
+            std::vector<uint8_t> pixels;
+        };
+
+        void workerLoop();
+        bool write(const Job& job) const;
+
+        std::string directory;
+        Format format;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable workCondition;
+        std::condition_variable spaceCondition;
+        std::deque<Job> jobs;
+        std::vector<std::vector<uint8_t>> freeBuffers;
+        size_t busyJobs = 0;
+        bool stopping = false;
+        std::atomic<uint32_t> writtenCount{ 0 };
+        std::atomic<uint32_t> failedCount{ 0 };
+    };
+
+}
+
+#endif
\ No newline at end of file
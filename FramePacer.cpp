@@ -0,0 +1,101 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        // Antes que cualquier oyente de escena, para arrancar el frame cuanto antes.
+        const int INPUT_PRIORITY = -1000001;
+
+    }
+
+    FramePacer* FramePacer::getInstance() {
+        static FramePacer instance;
+        return &instance;
+    }
+
+    void FramePacer::install(float rate) {
+        if (installed) {
+            return;
+        }
+        installed = true;
+        rallyRate = std::max(rate, NORMAL_RATE);
+
+        auto dispatcher = Director::getInstance()->getEventDispatcher();
+        auto keyboard = EventListenerKeyboard::create();
+        keyboard->onKeyPressed = [this](EventKeyboard::KeyCode, Event*) { onInput(); };
+        keyboard->onKeyReleased = keyboard->onKeyPressed;
+        dispatcher->addEventListenerWithFixedPriority(keyboard, INPUT_PRIORITY);
+
+        auto mouse = EventListenerMouse::create();
+        mouse->onMouseDown = [this](EventMouse*) { onInput(); };
+        mouse->onMouseUp = mouse->onMouseDown;
+        mouse->onMouseMove = mouse->onMouseDown;
+        mouse->onMouseScroll = mouse->onMouseDown;
+        dispatcher->addEventListenerWithFixedPriority(mouse, INPUT_PRIORITY);
+
+        // Al acabar la espera de la entrada se baja aunque la escena no vuelva a llamar.
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { refresh(); });
+
+        apply(Activity::NORMAL);
+    }
+
+    void FramePacer::setActivity(Activity activity) {
+        if (!installed) {
+            return;
+        }
+        requested = activity;
+        refresh();
+    }
+
+    void FramePacer::onInput() {
+        if (!installed) {
+            return;
+        }
+        holdUntil = utils::gettime() + INPUT_HOLD;
+        refresh();
+    }
+
+    void FramePacer::refresh() {
+        Activity target = requested;
+        if (target < Activity::NORMAL && utils::gettime() < holdUntil) {
+            target = Activity::NORMAL;
+        }
+        if (target != applied) {
+            apply(target);
+        }
+    }
+
+    void FramePacer::apply(Activity activity) {
+        auto director = Director::getInstance();
+        Activity previous = applied;
+        applied = activity;
+
+        switch (activity) {
+        case Activity::STOPPED:
+            // La aplicacion sigue leyendo la entrada al ritmo del intervalo,
+            // pero el Director no actualiza ni dibuja.
+            director->setAnimationInterval(1.0f / IDLE_RATE);
+            director->stopAnimation();
+            return;
+        case Activity::IDLE:
+            director->setAnimationInterval(1.0f / IDLE_RATE);
+            break;
+        case Activity::NORMAL:
+            director->setAnimationInterval(1.0f / NORMAL_RATE);
+            break;
+        case Activity::RALLY:
+            director->setAnimationInterval(1.0f / rallyRate);
+            break;
+        }
+
+        if (previous == Activity::STOPPED) {
+            // startAnimation pone el siguiente delta a cero: no hay salto tras la pausa.
+            director->startAnimation();
+        }
+    }
+
+}
\ No newline at end of file
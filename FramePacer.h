@@ -0,0 +1,56 @@
+#ifndef __FRAME_PACER_H__
+#define __FRAME_PACER_H__
+
+#include "cocos2d.h"
+
+namespace EpicGame {
+
+    // Ritmo de frames segun lo que pasa en pantalla. Las escenas dicen su
+    // actividad y el pacer ajusta el intervalo del Director:
+    //   STOPPED  nada se mueve: no se dibuja hasta la siguiente entrada
+    //   IDLE     temporizadores y animaciones lentas (IDLE_RATE)
+    //   NORMAL   60 fps
+    //   RALLY    pelota en juego: el refresco de la pantalla si es mayor
+    // Cualquier tecla o raton sube al menos a NORMAL en el mismo frame en que
+    // se procesa y lo mantiene INPUT_HOLD segundos para que la escena reaccione.
+    class FramePacer {
+    public:
+        enum class Activity {
+            STOPPED,
+            IDLE,
+            NORMAL,
+            RALLY
+        };
+
+        static constexpr float IDLE_RATE = 20.0f;
+        static constexpr float NORMAL_RATE = 60.0f;
+        static constexpr double INPUT_HOLD = 1.0;
+
+        static FramePacer* getInstance();
+
+        // rallyRate: refresco de la pantalla (<= NORMAL_RATE lo deja en 60).
+        void install(float rallyRate);
+        bool isInstalled() const { return installed; }
+
+        // Lo llaman las escenas; sin install no hace nada.
+        void setActivity(Activity activity);
+        void onInput();
+
+        Activity getActivity() const { return applied; }
+
+    private:
+        FramePacer() = default;
+
+        void refresh();
+        void apply(Activity activity);
+
+        bool installed = false;
+        float rallyRate = NORMAL_RATE;
+        Activity requested = Activity::NORMAL;
+        Activity applied = Activity::NORMAL;
+        double holdUntil = 0.0;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "InputLatencyHarness.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        void dispatchKey(EventKeyboard::KeyCode keyCode, bool pressed) {
+            EventKeyboard event(keyCode, pressed);
+            Director::getInstance()->getEventDispatcher()->dispatchEvent(&event);
+        }
+
+        double percentileOf(std::vector<double> values, double percentile) {
+            if (values.empty()) {
+                return 0.0;
+            }
+            size_t rank = static_cast<size_t>(percentile * (values.size() - 1) + 0.5);
+            std::nth_element(values.begin(), values.begin() + rank, values.end());
+            return values[rank];
+        }
+
+        const char* STAGE_NAMES[] = { "dispatch", "velocity", "present" };
+
+    }
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    PresentTimingView* PresentTimingView::createWithRect(const std::string& viewName, const Rect& rect) {
+        auto view = new (std::nothrow) PresentTimingView();
+        if (view && view->initWithRect(viewName, rect, 1.0f, false)) {
+            view->autorelease();
+            return view;
+        }
+        delete view;
+        return nullptr;
+    }
+
+    void PresentTimingView::swapBuffers() {
+        GLViewImpl::swapBuffers();
+        if (onPresent) {
+            onPresent();
+        }
+    }
+#endif
+
+    InputLatencyHarness::InputLatencyHarness(int trials, const std::string& outputPrefix, int stressRate,
+        const Hooks& hooks)
+        : trialCount(std::max(trials, 1)), outputPrefix(outputPrefix), stressRate(std::max(stressRate, 0)), hooks(hooks) {
+        this->trials.reserve(trialCount);
+    }
+
+    InputLatencyHarness::~InputLatencyHarness() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        armed.notify_all();
+        if (keyboard.joinable()) {
+            keyboard.join();
+        }
+        auto dispatcher = Director::getInstance()->getEventDispatcher();
+        for (EventListenerCustom* listener : listeners) {
+            dispatcher->removeEventListener(listener);
+        }
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+        if (presentHooked) {
+            auto view = static_cast<PresentTimingView*>(Director::getInstance()->getOpenGLView());
+            view->setPresentCallback(nullptr);
+        }
+#endif
+    }
+
+    void InputLatencyHarness::start() {
+        auto dispatcher = Director::getInstance()->getEventDispatcher();
+        listeners.push_back(dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE,
+            [this](EventCustom*) { onBeforeUpdate(); }));
+        listeners.push_back(dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE,
+            [this](EventCustom*) { onAfterUpdate(); }));
+        listeners.push_back(dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW,
+            [this](EventCustom*) { onAfterDraw(); }));
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+        auto view = dynamic_cast<PresentTimingView*>(Director::getInstance()->getOpenGLView());
+        if (view) {
+            view->setPresentCallback([this] { onPresent(); });
+            presentHooked = true;
+        }
+#endif
+        if (!presentHooked) {
+            CCLOG("Aviso: Sin PresentTimingView; present incluye la espera hasta el frame siguiente");
+        }
+
+        keyboard = std::thread(&InputLatencyHarness::keyboardLoop, this);
+        settleFrames = 2;
+        CCLOG("Prueba de latencia: %d pulsaciones, %d eventos/s de carga", trialCount, stressRate);
+    }
+
+    void InputLatencyHarness::keyboardLoop() {
+        auto scheduler = Director::getInstance()->getScheduler();
+        Clock::duration stressInterval = stressRate > 0 ?
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / stressRate)) :
+            Clock::duration::zero();
+        Clock::time_point nextStress = Clock::now();
+        bool stressDown = false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            Clock::time_point wake = pressPending ? pressAt : Clock::time_point::max();
+            if (stressRate > 0) {
+                wake = std::min(wake, nextStress);
+            }
+            if (wake == Clock::time_point::max()) {
+                armed.wait(lock);
+            }
+            else {
+                armed.wait_until(lock, wake);
+            }
+            if (stopping) {
+                break;
+            }
+
+            Clock::time_point now = Clock::now();
+            if (pressPending && now >= pressAt) {
+                pressPending = false;
+                // El instante de la pulsacion es cuando el "teclado" la entrega.
+                Clock::time_point pressed = Clock::now();
+                scheduler->performFunctionInCocosThread([this, pressed] { onKeyboardPress(pressed); });
+            }
+
+            // Si el hilo va con retraso manda de golpe todo lo que tocaba.
+            while (stressRate > 0 && nextStress <= now) {
+                stressDown = !stressDown;
+                bool down = stressDown;
+                scheduler->performFunctionInCocosThread([down] { dispatchKey(EventKeyboard::KeyCode::KEY_UP_ARROW, down); });
+                nextStress += stressInterval;
+                stressEvents++;
+            }
+        }
+    }
+
+    void InputLatencyHarness::armTrial() {
+        hooks.prepareTrial();
+
+        // La pulsacion cae en cualquier punto de los dos frames siguientes.
+        static std::minstd_rand rng(12345);
+        double frameSeconds = Director::getInstance()->getAnimationInterval();
+        std::uniform_real_distribution<double> offset(0.0, 2.0 * frameSeconds);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pressAt = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(offset(rng)));
+            pressPending = true;
+        }
+        armed.notify_one();
+
+        waitingPress = true;
+        framesWaited = 0;
+    }
+
+    void InputLatencyHarness::onKeyboardPress(Clock::time_point pressed) {
+        if (finished || !waitingPress) {
+            return;
+        }
+        pressTime = pressed;
+        waitingPress = false;
+        current.ms[DISPATCH] = elapsedMs(pressTime, Clock::now());
+
+        // velocity no se mira aqui aunque onKeyPressed ya haya golpeado: cuenta
+        // el primer update que deja la pelota con otra velocidad.
+        velocityBefore = hooks.ballVelocity();
+        dispatchKey(EventKeyboard::KeyCode::KEY_SPACE, true);
+        dispatchKey(EventKeyboard::KeyCode::KEY_SPACE, false);
+        waitingVelocity = true;
+    }
+
+    void InputLatencyHarness::onAfterUpdate() {
+        if (finished) {
+            return;
+        }
+        // La gravedad tambien cambia la velocidad en cada update, pero nunca
+        // la pone hacia arriba; eso solo lo hace el golpe.
+        if (waitingVelocity && hooks.ballVelocity().y > 0.0f && velocityBefore.y <= 0.0f) {
+            current.ms[VELOCITY] = elapsedMs(pressTime, Clock::now());
+            waitingVelocity = false;
+            waitingDraw = true;
+        }
+        if ((waitingPress || waitingVelocity) && ++framesWaited > TIMEOUT_FRAMES) {
+            finishTrial(false);
+        }
+    }
+
+    void InputLatencyHarness::onAfterDraw() {
+        if (waitingDraw) {
+            waitingDraw = false;
+            waitingPresent = true;
+        }
+    }
+
+    void InputLatencyHarness::onPresent() {
+        if (!finished && waitingPresent) {
+            current.ms[PRESENT] = elapsedMs(pressTime, Clock::now());
+            finishTrial(true);
+        }
+    }
+
+    void InputLatencyHarness::onBeforeUpdate() {
+        if (finished) {
+            return;
+        }
+        // Sin PresentTimingView: el frame anterior ya paso por swapBuffers.
+        if (waitingPresent && !presentHooked) {
+            current.ms[PRESENT] = elapsedMs(pressTime, Clock::now());
+            finishTrial(true);
+            return;
+        }
+        if (settleFrames > 0 && --settleFrames == 0) {
+            armTrial();
+        }
+    }
+
+    void InputLatencyHarness::finishTrial(bool hit) {
+        current.hit = hit;
+        trials.push_back(current);
+        current = Trial();
+        waitingPress = waitingVelocity = waitingDraw = waitingPresent = false;
+
+        if (static_cast<int>(trials.size()) >= trialCount) {
+            finish();
+            return;
+        }
+        settleFrames = 2;
+    }
+
+    void InputLatencyHarness::finish() {
+        finished = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            pressPending = false;
+        }
+        armed.notify_all();
+        if (keyboard.joinable()) {
+            keyboard.join();
+        }
+
+        std::vector<double> values[STAGE_COUNT];
+        int hits = 0;
+        for (const Trial& trial : trials) {
+            if (!trial.hit) {
+                continue;
+            }
+            hits++;
+            for (int stage = 0; stage < STAGE_COUNT; stage++) {
+                values[stage].push_back(trial.ms[stage]);
+            }
+        }
+
+        CCLOG("Latencia de entrada: %d de %zu pulsaciones golpearon, %llu eventos de carga", hits, trials.size(),
+            static_cast<unsigned long long>(stressEvents));
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            CCLOG("  %-8s p50 %.3f ms  p90 %.3f ms  p99 %.3f ms  max %.3f ms", STAGE_NAMES[stage],
+                percentileOf(values[stage], 0.5), percentileOf(values[stage], 0.9),
+                percentileOf(values[stage], 0.99), percentileOf(values[stage], 1.0));
+        }
+        if (!writeResults()) {
+            CCLOG("Error: No se pudieron guardar los resultados en %s_*.csv", outputPrefix.c_str());
+        }
+        Director::getInstance()->end();
+    }
+
+    bool InputLatencyHarness::writeResults() const {
+        FILE* file = fopen((outputPrefix + "_trials.csv").c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        fprintf(file, "trial,hit,dispatch_ms,velocity_ms,present_ms\n");
+        for (size_t i = 0; i < trials.size(); i++) {
+            const Trial& trial = trials[i];
+            fprintf(file, "%zu,%d,%.4f,%.4f,%.4f\n", i, trial.hit ? 1 : 0,
+                trial.ms[DISPATCH], trial.ms[VELOCITY], trial.ms[PRESENT]);
+        }
+        bool ok = fclose(file) == 0;
+
+        // El ultimo cubo recoge todo lo que pasa de HISTOGRAM_BINS * HISTOGRAM_BIN_MS.
+        std::vector<uint32_t> bins[STAGE_COUNT];
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            bins[stage].assign(HISTOGRAM_BINS, 0);
+        }
+        for (const Trial& trial : trials) {
+            if (!trial.hit) {
+                continue;
+            }
+            for (int stage = 0; stage < STAGE_COUNT; stage++) {
+                int bin = static_cast<int>(trial.ms[stage] / HISTOGRAM_BIN_MS);
+                bins[stage][std::min(std::max(bin, 0), HISTOGRAM_BINS - 1)]++;
+            }
+        }
+
+        file = fopen((outputPrefix + "_histogram.csv").c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        fprintf(file, "bin_ms,dispatch,velocity,present\n");
+        for (int bin = 0; bin < HISTOGRAM_BINS; bin++) {
+            fprintf(file, "%.2f,%u,%u,%u\n", bin * HISTOGRAM_BIN_MS, bins[DISPATCH][bin], bins[VELOCITY][bin], bins[PRESENT][bin]);
+        }
+        return fclose(file) == 0 && ok;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef __INPUT_LATENCY_HARNESS_H__
+#define __INPUT_LATENCY_HARNESS_H__
+
+#include "cocos2d.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EpicGame {
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    // GLViewImpl que avisa en cuanto vuelve swapBuffers. AppDelegate la usa
+    // en lugar de la normal cuando se mide la latencia.
+    class PresentTimingView : public cocos2d::GLViewImpl {
+    public:
+        static PresentTimingView* createWithRect(const std::string& viewName, const cocos2d::Rect& rect);
+
+        void swapBuffers() override;
+        void setPresentCallback(const std::function<void()>& callback) { onPresent = callback; }
+
+    private:
+        std::function<void()> onPresent;
+    };
+#endif
+
+    // Mide la latencia de golpe con teclas sinteticas. Un hilo hace de
+    // teclado: en un instante al azar de cada prueba "pulsa" SPACE y el
+    // evento entra al hilo de cocos como uno real, por
+    // performFunctionInCocosThread y el EventDispatcher. Por prueba se mide
+    // desde la pulsacion hasta:
+    //   - dispatch:  que el evento llega a los oyentes
+    //   - velocity:  el primer update tras la pulsacion con la pelota golpeada
+    //   - present:   que vuelve swapBuffers del primer frame con el cambio
+    //                (con PresentTimingView; sin ella, el inicio del frame
+    //                siguiente, que incluye la espera entre frames)
+    // Con stressRate > 0 el mismo hilo manda ademas pulsaciones de flecha
+    // arriba a ese ritmo (eventos/s) para cargar la cola de entrada.
+    class InputLatencyHarness {
+    public:
+        enum Stage {
+            DISPATCH,
+            VELOCITY,
+            PRESENT,
+            STAGE_COUNT
+        };
+
+        struct Hooks {
+            std::function<void()> prepareTrial;             // deja la pelota a tiro de player1
+            std::function<cocos2d::Vec2()> ballVelocity;
+        };
+
+        static constexpr double HISTOGRAM_BIN_MS = 0.25;
+        static const int HISTOGRAM_BINS = 400;              // hasta 100 ms
+        static const int TIMEOUT_FRAMES = 30;
+
+        InputLatencyHarness(int trials, const std::string& outputPrefix, int stressRate, const Hooks& hooks);
+        ~InputLatencyHarness();
+        InputLatencyHarness(const InputLatencyHarness&) = delete;
+        InputLatencyHarness& operator=(const InputLatencyHarness&) = delete;
+
+        // Se engancha al Director y empieza la primera prueba.
+        void start();
+        bool isFinished() const { return finished; }
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Trial {
+            double ms[STAGE_COUNT] = {};
+            bool hit = false;
+        };
+
+        void keyboardLoop();
+        void armTrial();
+        void onKeyboardPress(Clock::time_point pressTime);
+        void onAfterUpdate();
+        void onAfterDraw();
+        void onPresent();
+        void onBeforeUpdate();
+        void finishTrial(bool hit);
+        void finish();
+        bool writeResults() const;
+
+        static double elapsedMs(Clock::time_point from, Clock::time_point to) {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        }
+
+        int trialCount;
+        std::string outputPrefix;
+        int stressRate;
+        Hooks hooks;
+
+        std::vector<Trial> trials;
+        std::vector<cocos2d::EventListenerCustom*> listeners;
+        bool presentHooked = false;
+        bool finished = false;
+
+        // Estado de la prueba en curso (solo hilo de cocos).
+        bool waitingPress = false;
+        bool waitingVelocity = false;
+        bool waitingDraw = false;
+        bool waitingPresent = false;
+        int framesWaited = 0;
+        int settleFrames = 0;
+        cocos2d::Vec2 velocityBefore;
+        Clock::time_point pressTime;
+        Trial current;
+
+        // Hilo de teclado.
+        std::thread keyboard;
+        std::mutex mutex;
+        std::condition_variable armed;
+        Clock::time_point pressAt;
+        bool pressPending = false;
+        bool stopping = false;
+        uint64_t stressEvents = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
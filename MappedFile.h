@@ -0,0 +1,37 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <string>
+
+namespace EpicGame {
+
+    // Fichero mapeado en memoria de solo lectura (mmap / MapViewOfFile).
+    // Las paginas se cargan al leerlas y no se copia nada a la memoria del
+    // proceso.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return mapping != nullptr; }
+        const char* data() const { return static_cast<const char*>(mapping); }
+        size_t size() const { return mappingSize; }
+
+    private:
+        void* mapping = nullptr;
+        size_t mappingSize = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+}
+
+#endif
\ No newline at end of file
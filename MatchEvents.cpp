@@ -0,0 +1,42 @@
+#include "MatchEvents.h"
+#include <algorithm>
+
+namespace EpicGame {
+
+    const char* getEventName(MatchEventType type) {
+        switch (type) {
+        case MatchEventType::SERVE: return "SERVE";
+        case MatchEventType::SHOT_HIT: return "SHOT_HIT";
+        case MatchEventType::BOUNCE: return "BOUNCE";
+        case MatchEventType::FAULT: return "FAULT";
+        case MatchEventType::POINT_WON: return "POINT_WON";
+        case MatchEventType::GAME_WON: return "GAME_WON";
+        case MatchEventType::SET_WON: return "SET_WON";
+        }
+        return "UNKNOWN";
+    }
+
+    int MatchEventBus::subscribe(const Handler& handler) {
+        int id = nextHandlerId++;
+        handlers.emplace_back(id, handler);
+        return id;
+    }
+
+    void MatchEventBus::unsubscribe(int id) {
+        handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+            [id](const std::pair<int, Handler>& entry) { return entry.first == id; }), handlers.end());
+    }
+
+    size_t MatchEventBus::dispatch() {
+        size_t count = 0;
+        MatchEvent event;
+        while (ring.pop(event)) {
+            for (auto& entry : handlers) {
+                entry.second(event);
+            }
+            count++;
+        }
+        return count;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef __MATCH_EVENTS_H__
+#define __MATCH_EVENTS_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace EpicGame {
+
+    enum class MatchEventType : uint8_t {
+        SERVE,
+        SHOT_HIT,
+        BOUNCE,     // la pelota muere en la pista (fuera, sin fuerza); no incluye la red
+        FAULT,
+        POINT_WON,
+        GAME_WON,
+        SET_WON
+    };
+
+    const char* getEventName(MatchEventType type);
+
+    struct MatchEvent {
+        MatchEventType type = MatchEventType::SERVE;
+        uint8_t player = 0;     // quien saca, golpea, falla o gana; en BOUNCE, el campo donde bota
+        bool deuceSide = true;  // el que saca esta a la derecha de la pantalla (MatchScore::isDeuceSide)
+        float x = 0.0f;         // pelota en el momento del evento
+        float y = 0.0f;
+        float vx = 0.0f;
+        float vy = 0.0f;
+    };
+
+    // Cola circular sin bloqueos para un productor y un consumidor.
+    // Cada lado guarda una copia del indice del otro para no leer el atomico
+    // compartido en cada operacion.
+    template <typename T, size_t Capacity>
+    class SpscRing {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de 2");
+
+    public:
+        bool push(const T& item) {
+            size_t position = head.load(std::memory_order_relaxed);
+            if (position - cachedTail == Capacity) {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (position - cachedTail == Capacity) {
+                    return false;
+                }
+            }
+            items[position & (Capacity - 1)] = item;
+            head.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(T& item) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            if (position == cachedHead) {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (position == cachedHead) {
+                    return false;
+                }
+            }
+            item = items[position & (Capacity - 1)];
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        alignas(64) std::atomic<size_t> head{ 0 };
+        size_t cachedTail = 0;
+        alignas(64) std::atomic<size_t> tail{ 0 };
+        size_t cachedHead = 0;
+        alignas(64) T items[Capacity];
+    };
+
+    // La simulacion publica eventos (un solo hilo productor) y los
+    // suscriptores (marcador, estadisticas, log) los reciben en dispatch(),
+    // fuera del paso de simulacion. Publicar no reserva memoria ni llama a
+    // ningun suscriptor, asi que el coste del paso no crece con ellos.
+    class MatchEventBus {
+    public:
+        typedef std::function<void(const MatchEvent&)> Handler;
+
+        static constexpr size_t CAPACITY = 1024;
+
+        // Lado productor. Si la cola esta llena el evento se descarta y se cuenta.
+        void publish(const MatchEvent& event) {
+            if (!ring.push(event)) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Lado consumidor: suscribir, cancelar y repartir deben llamarse desde el mismo hilo.
+        int subscribe(const Handler& handler);
+        void unsubscribe(int id);
+        size_t dispatch();
+
+        uint64_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        SpscRing<MatchEvent, CAPACITY> ring;
+        std::vector<std::pair<int, Handler>> handlers;
+        int nextHandlerId = 1;
+        std::atomic<uint64_t> droppedCount{ 0 };
+    };
+
+}
+
+#endif
\ No newline at end of file
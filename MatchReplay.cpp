@@ -0,0 +1,151 @@
+#include "MatchReplay.h"
+#include "MatchStepper.h"
+#include "StateHash.h"
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace EpicGame {
+
+    static const char REPLAY_MAGIC[4] = { 'R', 'P', 'L', '1' };
+    static const uint32_t REPLAY_VERSION = 3;   // 2: golpes con efecto; 3: serveDelay en PlayerCommand
+
+    // Frames y estados se escriben tal cual: el fichero solo vale para la
+    // misma compilacion, que es justo lo que se quiere comparar.
+    static_assert(std::is_trivially_copyable<MatchReplay::Frame>::value, "Frame debe poder copiarse en bruto");
+    static_assert(std::is_trivially_copyable<MatchSim::State>::value, "State debe poder copiarse en bruto");
+
+    void MatchReplay::start(uint64_t newSeed, bool snapshotsEnabled) {
+        seed = newSeed;
+        withSnapshots = snapshotsEnabled;
+        frames.clear();
+        snapshots.clear();
+    }
+
+    void MatchReplay::record(float delta, const MatchSim::PlayerCommand& player1, const MatchSim::PlayerCommand& player2,
+        const MatchSim& sim) {
+        Frame frame;
+        frame.delta = delta;
+        frame.player1 = player1;
+        frame.player2 = player2;
+        frame.hash = sim.computeHash();
+        frames.push_back(frame);
+
+        if (withSnapshots) {
+            snapshots.push_back(sim.getState());
+        }
+    }
+
+    bool MatchReplay::save(const std::string& path) const {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+
+        uint64_t frameCount = frames.size();
+        uint32_t flags = withSnapshots ? 1 : 0;
+        uint32_t stateSize = sizeof(MatchSim::State);
+        fwrite(REPLAY_MAGIC, 1, sizeof(REPLAY_MAGIC), file);
+        fwrite(&REPLAY_VERSION, sizeof(REPLAY_VERSION), 1, file);
+        fwrite(&flags, sizeof(flags), 1, file);
+        fwrite(&stateSize, sizeof(stateSize), 1, file);
+        fwrite(&seed, sizeof(seed), 1, file);
+        fwrite(&frameCount, sizeof(frameCount), 1, file);
+        fwrite(frames.data(), sizeof(Frame), frames.size(), file);
+        if (withSnapshots) {
+            fwrite(snapshots.data(), sizeof(MatchSim::State), snapshots.size(), file);
+        }
+
+        bool ok = ferror(file) == 0;
+        fclose(file);
+        return ok;
+    }
+
+    bool MatchReplay::load(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+
+        char magic[4];
+        uint32_t version = 0;
+        uint32_t flags = 0;
+        uint32_t stateSize = 0;
+        uint64_t frameCount = 0;
+        bool ok = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+            memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0 &&
+            fread(&version, sizeof(version), 1, file) == 1 && version == REPLAY_VERSION &&
+            fread(&flags, sizeof(flags), 1, file) == 1 &&
+            fread(&stateSize, sizeof(stateSize), 1, file) == 1 && stateSize == sizeof(MatchSim::State) &&
+            fread(&seed, sizeof(seed), 1, file) == 1 &&
+            fread(&frameCount, sizeof(frameCount), 1, file) == 1;
+
+        if (ok) {
+            withSnapshots = (flags & 1) != 0;
+            frames.resize(static_cast<size_t>(frameCount));
+            ok = fread(frames.data(), sizeof(Frame), frames.size(), file) == frames.size();
+        }
+        if (ok && withSnapshots) {
+            snapshots.resize(frames.size());
+            ok = fread(snapshots.data(), sizeof(MatchSim::State), snapshots.size(), file) == snapshots.size();
+        }
+        else {
+            snapshots.clear();
+        }
+
+        fclose(file);
+        return ok;
+    }
+
+    MatchReplay::Divergence MatchReplay::verify(MatchSim& sim) const {
+        Divergence divergence;
+        sim.reset(seed);
+
+        MatchStepper<ReplayPlaybackPolicy, ReplayPlaybackPolicy> stepper(sim,
+            ReplayPlaybackPolicy(*this), ReplayPlaybackPolicy(*this));
+        for (size_t i = 0; i < frames.size(); i++) {
+            stepper.step(frames[i].delta);
+
+            uint64_t hash = sim.computeHash();
+            if (hash == frames[i].hash) {
+                continue;
+            }
+
+            divergence.found = true;
+            divergence.frame = i;
+            divergence.expectedHash = frames[i].hash;
+            divergence.actualHash = hash;
+
+            if (i < snapshots.size()) {
+                // Mismo orden de campos que el hash. Se compara el hash de cada
+                // campo para distinguir tambien 0.0f de -0.0f.
+                struct Field {
+                    uint64_t hash;
+                    double value;
+                };
+                std::vector<Field> expected;
+                MatchSim::visitFields(snapshots[i], [&expected](const char*, auto value) {
+                    StateHasher hasher;
+                    hasher.add(value);
+                    expected.push_back({ hasher.finish(), static_cast<double>(value) });
+                });
+
+                size_t index = 0;
+                MatchSim::visitFields(sim.getState(), [&](const char* name, auto value) {
+                    StateHasher hasher;
+                    hasher.add(value);
+                    if (divergence.field.empty() && hasher.finish() != expected[index].hash) {
+                        divergence.field = name;
+                        divergence.expectedValue = expected[index].value;
+                        divergence.actualValue = static_cast<double>(value);
+                    }
+                    index++;
+                });
+            }
+            break;
+        }
+
+        return divergence;
+    }
+
+}
\ No newline at end of file
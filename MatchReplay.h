@@ -0,0 +1,58 @@
+#ifndef __MATCH_REPLAY_H__
+#define __MATCH_REPLAY_H__
+
+#include "MatchSim.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    // Entradas de cada paso de MatchSim con el hash del estado resultante.
+    // Con snapshots tambien guarda el estado completo para poder decir que
+    // campo fue el primero en cambiar.
+    class MatchReplay {
+    public:
+        struct Frame {
+            float delta = 0.0f;
+            MatchSim::PlayerCommand player1;
+            MatchSim::PlayerCommand player2;
+            uint64_t hash = 0;
+        };
+
+        struct Divergence {
+            bool found = false;
+            size_t frame = 0;
+            uint64_t expectedHash = 0;
+            uint64_t actualHash = 0;
+            std::string field;          // vacio si la repeticion no tiene snapshots
+            double expectedValue = 0.0;
+            double actualValue = 0.0;
+        };
+
+        void start(uint64_t seed, bool withSnapshots);
+        void record(float delta, const MatchSim::PlayerCommand& player1, const MatchSim::PlayerCommand& player2,
+            const MatchSim& sim);
+
+        bool save(const std::string& path) const;
+        bool load(const std::string& path);
+
+        // Reproduce las entradas desde la semilla y se para en el primer
+        // frame cuyo hash no coincide.
+        Divergence verify(MatchSim& sim) const;
+
+        uint64_t getSeed() const { return seed; }
+        size_t size() const { return frames.size(); }
+        const Frame& getFrame(size_t index) const { return frames[index]; }
+        bool hasSnapshots() const { return !snapshots.empty(); }
+
+    private:
+        uint64_t seed = 0;
+        bool withSnapshots = false;
+        std::vector<Frame> frames;
+        std::vector<MatchSim::State> snapshots;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,458 @@
+#include "MatchSim.h"
+#include "ShotTable.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace EpicGame {
+
+    // Ancho de player1.png (360) por FRONT_PLAYER_SCALE, a la mitad.
+    static const float PLAYER1_HALF_WIDTH = 72.0f;
+
+    MatchSim::MatchSim()
+        : MatchSim(CourtGeometry::fromVisibleSize(DESIGN_WIDTH, DESIGN_HEIGHT)) {
+    }
+
+    MatchSim::MatchSim(const CourtGeometry& geometry) {
+        court.width = geometry.width;
+        court.height = geometry.height;
+        court.courtWidth = geometry.courtWidth;
+        court.courtHeight = geometry.courtHeight;
+        court.baselineOffset = geometry.baselineOffset;
+        SpinTable::getInstance();   // se calcula aqui y no en el primer golpe con efecto
+        reset(1);
+    }
+
+    void MatchSim::reset(uint64_t seed) {
+        rng.seed(static_cast<std::minstd_rand::result_type>(seed % 2147483646u) + 1u);
+        state = State();
+        positionPlayersForServe();
+
+        scheduler.cancelAll();
+        scheduler.start(serveSequence());
+    }
+
+    bool MatchSim::advance(float frameTime, const PlayerCommand& player1, const PlayerCommand& player2,
+        StepResult& result) {
+        Scalar delta = frameTime;
+        stepDelta = delta;
+
+        switch (state.gameState) {
+        case GameState::SERVE:
+            stepResult = &result;
+            scheduler.tick(frameTime);
+            break;
+
+        case GameState::PLAY:
+            tryHit(1, player1);
+            movePlayer(1, delta, player1);
+
+            // Los golpes con efecto siguen su tabla; no entran en el lote.
+            if (state.spin.shot != ShotType::NORMAL) {
+                bool player1Won = false;
+                FlightResult flight = SpinTable::step(state.ball, state.spin, delta, court, player1Won);
+                finishPlay(flight, player1Won, player2, result);
+                break;
+            }
+            flightStartX = state.ball.x;
+            flightStartY = state.ball.y;
+            return true;
+
+        case GameState::POINT_END:
+            startNewPoint();
+            break;
+        }
+
+        return false;
+    }
+
+    void MatchSim::finishStep(const PlayerCommand& player2, StepResult& result) {
+        bool player1Won = false;
+        FlightResult flight = BallFlight::resolve(state.ball, flightStartX, flightStartY, court, player1Won);
+        finishPlay(flight, player1Won, player2, result);
+    }
+
+    // Secuencia de saque: se reanuda solo en los pasos con gameState == SERVE
+    // (stepDelta y stepServe son los de ese paso) y vuelve a empezar tras
+    // cada golpe o falta. La espera con la pelota en la mano no reanuda la
+    // corrutina: la IA duerme serveDelay y el teclado espera con until().
+    // El lanzamiento si avanza paso a paso porque la pelota se dibuja.
+    Sequence MatchSim::serveSequence() {
+        for (;;) {
+            co_await scheduler.nextFrame();
+            Scalar side = state.score.servingPlayer == 1 ? 1.0f : -1.0f;
+            state.ball.x = serverX();
+            state.ball.y = serverY() + side * SERVE_START_HEIGHT;
+            state.ball.vx = state.ball.vy = 0.0f;
+
+            // Con latencia el serveDelay puede llegar unos pasos tarde.
+            co_await scheduler.until([this] { return stepServe.ready; });
+            if (stepServe.delay >= 0.0f) {
+                co_await scheduler.delay(stepServe.delay);
+            }
+            state.serveState = ServeState::TOSS;
+            state.serveTimer = 0.0f;
+
+            // Lanzamiento. Solo se puede golpear dentro de la ventana; si se
+            // pasa, la pelota cae y es falta.
+            bool served = false;
+            while (!served) {
+                co_await scheduler.nextFrame();
+                state.serveTimer += stepDelta;
+                Scalar progress = state.serveTimer / SERVE_DURATION;
+                if (progress > 1.0f) {
+                    state.serveState = ServeState::FALLING;
+                    state.ball.vx = state.ball.vy = 0.0f;
+                    break;
+                }
+
+                Scalar height = SERVE_HEIGHT * (1 - (2 * progress - 1) * (2 * progress - 1));
+                state.ball.x = serverX() + 10.0f * scalarSinPi(progress);
+                state.ball.y = serverY() + side * (SERVE_START_HEIGHT + height);
+
+                if (progress > 0.5f && progress < 0.8f) {
+                    state.serveState = ServeState::READY_TO_HIT;
+                    if (stepServe.ready) {
+                        hitServe();
+                        served = true;
+                    }
+                }
+                else if (state.serveState == ServeState::READY_TO_HIT) {
+                    state.serveState = ServeState::TOSS;
+                }
+            }
+            if (served) {
+                continue;
+            }
+
+            for (;;) {
+                co_await scheduler.nextFrame();
+                state.ball.vy += side * BallFlight::GRAVITY * stepDelta;
+                state.ball.x += state.ball.vx * stepDelta;
+                state.ball.y += state.ball.vy * stepDelta;
+
+                if (side * (state.ball.y - (serverY() + side * SERVE_START_HEIGHT)) <= 0.0f) {
+                    break;
+                }
+            }
+
+            publish(MatchEventType::FAULT, state.score.servingPlayer);
+            state.score.faultCount++;
+            if (state.score.faultCount >= 2) {
+                endPoint(state.score.servingPlayer == 2, *stepResult);
+            }
+            else {
+                state.serveState = ServeState::READY;
+                state.serveTimer = 0.0f;
+            }
+        }
+    }
+
+    void MatchSim::finishPlay(FlightResult flight, bool player1Won, const PlayerCommand& player2, StepResult& result) {
+        if (flight != FlightResult::IN_PLAY) {
+            if (flight != FlightResult::NET) {
+                publish(MatchEventType::BOUNCE, state.ball.y < court.height * 0.5f ? 1 : 2);
+            }
+            endPoint(player1Won, result);
+            return;
+        }
+
+        movePlayer(2, stepDelta, player2);
+        tryHit(2, player2);
+
+        // En el aire sobre las lineas todavia no esta fuera; lo decide el bote.
+        if (state.spin.shot == ShotType::NORMAL && BallFlight::isOutOfCourt(state.ball, court)) {
+            publish(MatchEventType::BOUNCE, state.ball.y < court.height * 0.5f ? 1 : 2);
+            endPoint(state.ball.vy < 0, result);
+        }
+    }
+
+    bool MatchSim::tryHit(int player, const PlayerCommand& command) {
+        if (!command.swing) {
+            return false;
+        }
+        if (state.spin.shot != ShotType::NORMAL && state.spin.height > SpinTable::REACH_HEIGHT) {
+            return false;
+        }
+
+        Scalar forward;
+        if (player == 1) {
+            if (scalarAbs(state.ball.x - state.player1X) >= 100.0f || state.ball.y >= court.height * 0.4f) {
+                return false;
+            }
+            forward = 1.0f;
+        }
+        else {
+            if (state.ball.y < court.height * 0.7f || scalarAbs(state.ball.x - state.player2X) >= 60.0f) {
+                return false;
+            }
+            forward = -1.0f;
+        }
+
+        Scalar dx = command.aimX;
+        Scalar dy = command.aimY * forward;
+        Scalar length = scalarLength(dx, dy);
+        if (length <= 0.0f) {
+            return false;
+        }
+
+        state.ball.vx = dx / length * command.hitSpeed;
+        state.ball.vy = dy / length * command.hitSpeed;
+        SpinTable::launch(state.spin, state.ball, command.shot, Scalar(command.spin), court);
+        publish(MatchEventType::SHOT_HIT, player);
+        return true;
+    }
+
+    void MatchSim::movePlayer(int player, Scalar delta, const PlayerCommand& command) {
+        if (command.moveSpeed == 0.0f) {
+            return;
+        }
+
+        if (player == 1) {
+            Scalar minX = (court.width - court.courtWidth) / 2 + PLAYER1_HALF_WIDTH;
+            Scalar maxX = (court.width + court.courtWidth) / 2 - PLAYER1_HALF_WIDTH;
+            state.player1X = std::min(std::max(state.player1X + command.moveSpeed * delta, minX), maxX);
+        }
+        else {
+            Scalar minX = court.width * 0.1f;
+            Scalar maxX = court.width * 0.9f;
+            state.player2X = std::min(std::max(state.player2X + command.moveSpeed * delta, minX), maxX);
+            state.player2Y = court.height * 0.85f;
+        }
+    }
+
+    void MatchSim::hitServe() {
+        Scalar centerX = court.width * 0.5f;
+        Scalar dx, dy, speed;
+
+        if (state.score.servingPlayer == 2) {
+            Scalar targetX = state.score.isDeuceSide ? centerX - court.width * 0.25f : centerX + court.width * 0.25f;
+            dx = (targetX - state.ball.x) / (court.width * 0.3f);
+            dy = -2.0f;
+            speed = 600.0f;
+        }
+        else {
+            Scalar targetX = state.score.isDeuceSide ? centerX - court.width * 0.15f : centerX + court.width * 0.15f;
+            dx = (targetX - state.ball.x) / (court.width * 0.3f);
+            dy = 2.0f;
+            speed = 700.0f;
+        }
+
+        Scalar length = scalarLength(dx, dy);
+        state.ball.vx = dx / length * speed;
+        state.ball.vy = dy / length * speed;
+        publish(MatchEventType::SERVE, state.score.servingPlayer);
+
+        state.ballInPlay = true;
+        state.serveState = ServeState::READY;
+        state.gameState = GameState::PLAY;
+    }
+
+    void MatchSim::endPoint(bool player1Won, StepResult& result) {
+        state.ballInPlay = false;
+        state.serveState = ServeState::READY;
+        state.ball.vx = state.ball.vy = 0.0f;
+        state.spin = SpinFlightT<Scalar>();
+
+        result.pointEnded = true;
+        result.player1Won = player1Won;
+        int setsBefore = state.score.player1Sets + state.score.player2Sets;
+        result.gameWon = state.score.awardPoint(player1Won);
+
+        int winner = player1Won ? 1 : 2;
+        publish(MatchEventType::POINT_WON, winner);
+        if (result.gameWon) {
+            publish(MatchEventType::GAME_WON, winner);
+        }
+        if (state.score.player1Sets + state.score.player2Sets != setsBefore) {
+            publish(MatchEventType::SET_WON, winner);
+        }
+
+        if (result.gameWon) {
+            state.score.switchServer();
+        }
+        else {
+            state.score.alternateServiceSide();
+        }
+
+        state.gameState = GameState::POINT_END;
+    }
+
+    void MatchSim::startNewPoint() {
+        state.score.faultCount = 0;
+        state.gameState = GameState::SERVE;
+        state.serveState = ServeState::READY;
+        state.serveTimer = 0.0f;
+        state.ballInPlay = false;
+        state.ball.vx = state.ball.vy = 0.0f;
+        positionPlayersForServe();
+    }
+
+    uint64_t MatchSim::computeHash() const {
+        StateHasher hasher;
+        visitFields(state, [&hasher](const char*, auto value) { hasher.add(value); });
+        return hasher.finish();
+    }
+
+    void MatchSim::publish(MatchEventType type, int player) {
+        if (events) {
+            MatchEvent event;
+            event.type = type;
+            event.player = static_cast<uint8_t>(player);
+            event.deuceSide = state.score.isDeuceSide;
+            event.x = toFloat(state.ball.x);
+            event.y = toFloat(state.ball.y);
+            event.vx = toFloat(state.ball.vx);
+            event.vy = toFloat(state.ball.vy);
+            events->publish(event);
+        }
+    }
+
+    void MatchSim::positionPlayersForServe() {
+        Scalar centerX = court.width * 0.5f;
+        Scalar frontBaselineY = court.height * 0.2f;
+        Scalar backBaselineY = court.height * 0.92f;
+        Scalar centerOffset = court.width * 0.05f;
+
+        state.player1Y = frontBaselineY;
+        state.player2Y = backBaselineY;
+
+        if (state.score.servingPlayer == 2) {
+            state.player2X = state.score.isDeuceSide ? centerX + centerOffset : centerX - centerOffset;
+            state.player1X = state.score.isDeuceSide ? centerX - centerOffset : centerX + centerOffset;
+            state.ball.x = state.player2X;
+            state.ball.y = state.player2Y - SERVE_START_HEIGHT;
+        }
+        else {
+            state.player1X = state.score.isDeuceSide ? centerX + centerOffset : centerX - centerOffset;
+            state.player2X = state.score.isDeuceSide ? centerX - court.width * 0.2f : centerX + court.width * 0.2f;
+            state.ball.x = state.player1X;
+            state.ball.y = state.player1Y + SERVE_START_HEIGHT;
+        }
+    }
+
+    Scalar MatchSim::serverX() const {
+        return state.score.servingPlayer == 1 ? state.player1X : state.player2X;
+    }
+
+    Scalar MatchSim::serverY() const {
+        return state.score.servingPlayer == 1 ? state.player1Y : state.player2Y;
+    }
+
+    MatchSim::PlayerCommand MatchSim::scriptedCommand(int player) {
+        return scriptedCommand(player, AIProfile());
+    }
+
+    MatchSim::PlayerCommand MatchSim::scriptedCommand(int player, const AIProfile& profile) {
+        PlayerCommand command;
+
+        if (state.gameState == GameState::SERVE) {
+            if (state.score.servingPlayer == player) {
+                command.serveDelay = AI_SERVE_DELAY;
+            }
+            return command;
+        }
+
+        if (state.gameState != GameState::PLAY) {
+            return command;
+        }
+
+        // Todo se calcula como si el jugador estuviera arriba (player2) y se
+        // refleja en vertical para player1.
+        Scalar ownX = player == 2 ? state.player2X : state.player1X;
+        Scalar opponentX = player == 2 ? state.player1X : state.player2X;
+        Scalar ballX = state.ball.x;
+        Scalar ballY = player == 2 ? state.ball.y : court.height - state.ball.y;
+        Scalar ballVy = player == 2 ? state.ball.vy : -state.ball.vy;
+
+        if (ballY <= court.height * 0.5f) {
+            return command;
+        }
+
+        if (scalarAbs(ballX - ownX) > 10.0f) {
+            command.moveSpeed = (ballX > ownX ? 1.0f : -1.0f) * AI_SPEED * profile.moveFactor;
+        }
+
+        if (ballY >= court.height * 0.7f && scalarAbs(ballX - ownX) < profile.reach &&
+            static_cast<int>(rng() % 100) < profile.hitChance) {
+            Scalar targetX;
+            float tableTargetX;
+            float hitSpeed = AI_HIT_SPEED;
+            if (profile.useShotTable && ShotTable::getInstance()->lookup(toFloat(ballX / court.width), toFloat(ballY / court.height),
+                toFloat(state.ball.vx), toFloat(ballVy), toFloat(ownX / court.width), tableTargetX, hitSpeed)) {
+                targetX = tableTargetX * court.width;
+            }
+            else {
+                float randomOffset = (static_cast<int>(rng() % 300) - 150) / 100.0f;
+                targetX = opponentX + randomOffset * court.width * profile.aimSpread;
+            }
+
+            command.swing = true;
+            command.aimX = toFloat((targetX - ballX) / (court.width * 0.5f));
+            command.aimY = 2.0f;
+            command.hitSpeed = hitSpeed * profile.hitSpeedScale;
+
+            // Sin spinShotChance no se toca rng: la IA por defecto no cambia.
+            if (profile.spinShotChance > 0) {
+                ShotType shot = ShotType::NORMAL;
+                if (state.spin.shot == ShotType::LOB) {
+                    shot = ShotType::SMASH;
+                }
+                else if (static_cast<int>(rng() % 100) < profile.spinShotChance) {
+                    shot = static_cast<ShotType>(static_cast<int>(ShotType::TOPSPIN) + rng() % 3);
+                }
+                if (shot != ShotType::NORMAL) {
+                    setShot(command, shot);
+                    command.hitSpeed *= profile.hitSpeedScale;
+                }
+            }
+        }
+
+        return command;
+    }
+
+    MatchSim::PlayerCommand MatchSim::keyboardCommand(bool left, bool right, bool up, bool down, bool space,
+        ShotType shot) {
+        PlayerCommand command;
+        if (left) command.moveSpeed -= PLAYER_SPEED;
+        if (right) command.moveSpeed += PLAYER_SPEED;
+
+        command.swing = space;
+        command.aimY = up ? 1.2f : (down ? 0.8f : 1.0f);
+        if (left) command.aimX -= 0.5f;
+        if (right) command.aimX += 0.5f;
+        command.hitSpeed = HIT_BASE_SPEED;
+        if (shot != ShotType::NORMAL) {
+            command.swing = true;
+            setShot(command, shot);
+        }
+        return command;
+    }
+
+    // Velocidad y efecto de cada golpe, los mismos que TennisScene::executeShot.
+    void MatchSim::setShot(PlayerCommand& command, ShotType shot) {
+        command.shot = shot;
+        switch (shot) {
+        case ShotType::TOPSPIN:
+            command.hitSpeed = HIT_SPEED;
+            command.spin = BALL_SPIN;
+            break;
+        case ShotType::SLICE:
+            command.hitSpeed = HIT_BASE_SPEED;
+            command.spin = BALL_SPIN;
+            break;
+        case ShotType::LOB:
+            command.hitSpeed = LOB_SPEED;
+            command.spin = BALL_SPIN * 0.5f;
+            break;
+        case ShotType::SMASH:
+            command.hitSpeed = SMASH_SPEED;
+            command.spin = BALL_SPIN * 0.25f;
+            break;
+        default:
+            command.spin = 0.0f;
+            break;
+        }
+    }
+
+}
\ No newline at end of file
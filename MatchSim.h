@@ -0,0 +1,249 @@
+#ifndef __MATCH_SIM_H__
+#define __MATCH_SIM_H__
+
+#include "BallFlight.h"
+#include "MatchEvents.h"
+#include "Sequence.h"
+#include "SpinTable.h"
+#include "TennisRules.h"
+#include <cstdint>
+#include <random>
+
+namespace EpicGame {
+
+    // Partido completo sin ventana: saque, movimiento, golpes, fisica de la
+    // pelota y marcador, con las mismas reglas que TennisScene. Cada jugador
+    // se controla con un PlayerCommand por paso, asi que sirve igual para un
+    // agente externo, la IA de updateAI o una reproduccion. El estado usa
+    // Scalar: con TENNIS_FIXED_POINT toda la cinematica es Q16.16 y el
+    // resultado es identico bit a bit en cualquier maquina.
+    class MatchSim {
+    public:
+        static constexpr float DESIGN_WIDTH = 1280.0f;
+        static constexpr float DESIGN_HEIGHT = 720.0f;
+
+        static constexpr float SERVE_HEIGHT = 100.0f;
+        static constexpr float SERVE_START_HEIGHT = 30.0f;
+        static constexpr float SERVE_DURATION = 0.8f;
+        static constexpr float AI_SERVE_DELAY = 1.0f;
+        static constexpr float PLAYER_SPEED = 400.0f;
+        static constexpr float AI_SPEED = 500.0f;
+        static constexpr float HIT_BASE_SPEED = 500.0f;
+        static constexpr float AI_HIT_SPEED = 550.0f;
+        static constexpr float HIT_SPEED = 750.0f;
+        static constexpr float LOB_SPEED = 450.0f;
+        static constexpr float SMASH_SPEED = 750.0f;
+        static constexpr float BALL_SPIN = 0.2f;
+
+        enum class GameState : uint8_t {
+            SERVE,
+            PLAY,
+            POINT_END
+        };
+
+        enum class ServeState : uint8_t {
+            READY,
+            TOSS,
+            READY_TO_HIT,
+            FALLING
+        };
+
+        struct PlayerCommand {
+            float moveSpeed = 0.0f;   // pixeles/s, negativo hacia la izquierda
+            bool swing = false;       // saque o golpe en este paso
+            ShotType shot = ShotType::NORMAL;
+            float aimX = 0.0f;        // direccion del golpe antes de normalizar
+            float aimY = 1.0f;        // hacia el campo rival
+            float hitSpeed = 0.0f;
+            float spin = 0.0f;        // solo con shot != NORMAL
+            float serveDelay = -1.0f; // >= 0: saca tras esperar esto (s) y golpea al abrirse la ventana, sin mirar swing
+        };
+
+        // Origen de los comandos de un jugador. MatchStepper lo saca del tipo
+        // de cada politica, asi que step<>() compila para cada pareja solo la
+        // condicion de saque que usa ese origen: el teclado saca con swing y
+        // la IA con serveDelay. Las repeticiones pueden traer las dos.
+        enum class CommandSource : uint8_t {
+            KEYBOARD,
+            SCRIPTED,
+            RECORDED
+        };
+
+        // Parametros de scriptedCommand. Los valores por defecto son la IA de
+        // TennisScene; los torneos comparan variantes.
+        struct AIProfile {
+            float moveFactor = 0.85f;     // fraccion de AI_SPEED
+            float reach = 60.0f;          // distancia en x a la que intenta golpear
+            int hitChance = 75;           // % de pasos en alcance en que golpea
+            float hitSpeedScale = 1.0f;
+            float aimSpread = 0.15f;      // error de apuntado sin ShotTable, en anchos de pista
+            bool useShotTable = true;
+            int spinShotChance = 0;       // % de golpes con liftado, cortado o globo; remata los globos
+        };
+
+        struct State {
+            BallStateT<Scalar> ball;
+            SpinFlightT<Scalar> spin;
+            Scalar player1X = 0.0f;
+            Scalar player1Y = 0.0f;
+            Scalar player2X = 0.0f;
+            Scalar player2Y = 0.0f;
+            GameState gameState = GameState::SERVE;
+            ServeState serveState = ServeState::READY;
+            Scalar serveTimer = 0.0f;
+            bool ballInPlay = false;
+            MatchScore score;
+        };
+
+        struct StepResult {
+            bool pointEnded = false;
+            bool player1Won = false;
+            bool gameWon = false;
+        };
+
+        MatchSim();
+        explicit MatchSim(const CourtGeometry& court);
+        // La secuencia de saque guarda this; no se puede copiar ni mover.
+        MatchSim(const MatchSim&) = delete;
+        MatchSim& operator=(const MatchSim&) = delete;
+
+        void reset(uint64_t seed);
+
+        // Sin origen indicado se acepta cualquier saque, como en RECORDED.
+        template <CommandSource Player1Source = CommandSource::RECORDED,
+                  CommandSource Player2Source = CommandSource::RECORDED>
+        StepResult step(float frameTime, const PlayerCommand& player1, const PlayerCommand& player2) {
+            StepResult result;
+            if (beginStep<Player1Source, Player2Source>(frameTime, player1, player2, result)) {
+                BallFlight::integrate(state.ball, stepDelta);
+                finishStep(player2, result);
+            }
+            return result;
+        }
+
+        // step() en dos mitades, para que VecEnv integre juntas las pelotas de
+        // todos sus partidos (BallFlight::integrateBatch en Q16.16). Si
+        // beginStep devuelve true falta integrar getFlightBall() con el mismo
+        // frameTime y llamar a finishStep con el comando de player2 del paso;
+        // si devuelve false el paso ya esta completo.
+        template <CommandSource Player1Source = CommandSource::RECORDED,
+                  CommandSource Player2Source = CommandSource::RECORDED>
+        bool beginStep(float frameTime, const PlayerCommand& player1, const PlayerCommand& player2, StepResult& result) {
+            if (state.gameState == GameState::SERVE) {
+                stepServe = state.score.servingPlayer == 1 ?
+                    serveRequest<Player1Source>(player1) : serveRequest<Player2Source>(player2);
+            }
+            return advance(frameTime, player1, player2, result);
+        }
+        BallStateT<Scalar>& getFlightBall() { return state.ball; }
+        void finishStep(const PlayerCommand& player2, StepResult& result);
+
+        // Comandos de la IA de TennisScene::updateAI para cualquiera de los dos jugadores.
+        PlayerCommand scriptedCommand(int player);
+        PlayerCommand scriptedCommand(int player, const AIProfile& profile);
+        // Golpe del teclado de TennisScene::onKeyPressed; con shot, el de executeShot.
+        static PlayerCommand keyboardCommand(bool left, bool right, bool up, bool down, bool space,
+            ShotType shot = ShotType::NORMAL);
+
+        // Opcional: sin bus (por defecto) la simulacion no publica nada.
+        void setEventBus(MatchEventBus* bus) { events = bus; }
+
+        // Hash de todo el estado tras el ultimo paso. rng no entra: solo lo usa
+        // scriptedCommand y sus comandos ya son entradas de step().
+        uint64_t computeHash() const;
+
+        // Recorre los campos de State con su nombre, siempre en el mismo orden.
+        // Lo usan el hash y el comprobador de repeticiones.
+        template <typename Visitor>
+        static void visitFields(const State& s, Visitor&& visit) {
+            visit("ball.x", s.ball.x);
+            visit("ball.y", s.ball.y);
+            visit("ball.vx", s.ball.vx);
+            visit("ball.vy", s.ball.vy);
+            visit("spin.shot", static_cast<int>(s.spin.shot));
+            visit("spin.time", s.spin.time);
+            visit("spin.originX", s.spin.originX);
+            visit("spin.originY", s.spin.originY);
+            visit("spin.dirX", s.spin.dirX);
+            visit("spin.dirY", s.spin.dirY);
+            visit("spin.speed", s.spin.speed);
+            visit("spin.spin", s.spin.spin);
+            visit("spin.height", s.spin.height);
+            visit("player1X", s.player1X);
+            visit("player1Y", s.player1Y);
+            visit("player2X", s.player2X);
+            visit("player2Y", s.player2Y);
+            visit("gameState", static_cast<int>(s.gameState));
+            visit("serveState", static_cast<int>(s.serveState));
+            visit("serveTimer", s.serveTimer);
+            visit("ballInPlay", s.ballInPlay);
+            visit("score.player1Points", s.score.player1Points);
+            visit("score.player2Points", s.score.player2Points);
+            visit("score.player1Games", s.score.player1Games);
+            visit("score.player2Games", s.score.player2Games);
+            visit("score.player1Sets", s.score.player1Sets);
+            visit("score.player2Sets", s.score.player2Sets);
+            visit("score.isDeuce", s.score.isDeuce);
+            visit("score.servingPlayer", s.score.servingPlayer);
+            visit("score.isDeuceSide", s.score.isDeuceSide);
+            visit("score.faultCount", s.score.faultCount);
+        }
+
+        const State& getState() const { return state; }
+        const CourtGeometryT<Scalar>& getCourt() const { return court; }
+
+    private:
+        // Lo que pide el que saca en este paso, leido segun su CommandSource.
+        struct ServeRequest {
+            bool ready = false;     // quiere sacar, o golpear si la pelota esta en la ventana
+            float delay = -1.0f;    // >= 0: espera esto antes de lanzar
+        };
+
+        template <CommandSource Source>
+        static ServeRequest serveRequest(const PlayerCommand& command) {
+            ServeRequest request;
+            if constexpr (Source == CommandSource::KEYBOARD) {
+                request.ready = command.swing;
+            }
+            else if constexpr (Source == CommandSource::SCRIPTED) {
+                request.ready = command.serveDelay >= 0.0f;
+                request.delay = command.serveDelay;
+            }
+            else {
+                request.ready = command.swing || command.serveDelay >= 0.0f;
+                request.delay = command.swing ? -1.0f : command.serveDelay;
+            }
+            return request;
+        }
+
+        bool advance(float frameTime, const PlayerCommand& player1, const PlayerCommand& player2, StepResult& result);
+        Sequence serveSequence();
+        void finishPlay(FlightResult flight, bool player1Won, const PlayerCommand& player2, StepResult& result);
+        bool tryHit(int player, const PlayerCommand& command);
+        void movePlayer(int player, Scalar delta, const PlayerCommand& command);
+        void hitServe();
+        void endPoint(bool player1Won, StepResult& result);
+        void startNewPoint();
+        void positionPlayersForServe();
+        void publish(MatchEventType type, int player);
+        static void setShot(PlayerCommand& command, ShotType shot);
+
+        Scalar serverX() const;
+        Scalar serverY() const;
+
+        CourtGeometryT<Scalar> court;
+        State state;
+        std::minstd_rand rng;
+        MatchEventBus* events = nullptr;
+
+        SequenceScheduler scheduler;
+        Scalar stepDelta = 0.0f;
+        Scalar flightStartX = 0.0f;
+        Scalar flightStartY = 0.0f;
+        ServeRequest stepServe;
+        StepResult* stepResult = nullptr;
+    };
+
+}
+
+#endif
\ No newline at end of file
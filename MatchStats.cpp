@@ -0,0 +1,202 @@
+#include "MatchStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace EpicGame {
+
+    static const char* const COLUMN_NAMES[] = {
+        "seed", "steps", "winner", "points", "games", "sets", "rally_shots", "longest_rally",
+        "p1_double_faults", "p1_shots", "p1_avg_shot_speed", "p1_max_shot_speed",
+        "p1_points_won", "p1_deuce_side_won", "p1_ad_side_won", "p1_service_played", "p1_service_won",
+        "p2_double_faults", "p2_shots", "p2_avg_shot_speed", "p2_max_shot_speed",
+        "p2_points_won", "p2_deuce_side_won", "p2_ad_side_won", "p2_service_played", "p2_service_won"
+    };
+
+    static_assert(sizeof(COLUMN_NAMES) / sizeof(COLUMN_NAMES[0]) == MatchStatsTable::COLUMN_COUNT,
+        "Falta el nombre de alguna columna");
+
+    void MatchStatsAccumulator::onEvent(const MatchEvent& event) {
+        switch (event.type) {
+        case MatchEventType::SERVE:
+            server = event.player;
+            pointShots = 0;
+            break;
+
+        case MatchEventType::FAULT:
+            server = event.player;
+            pointFaults++;
+            if (pointFaults == 2 && server >= 1 && server <= 2) {
+                stats.players[server - 1].doubleFaults++;
+            }
+            break;
+
+        case MatchEventType::SHOT_HIT:
+            if (event.player >= 1 && event.player <= 2) {
+                PlayerStats& player = stats.players[event.player - 1];
+                float speed = std::sqrt(event.vx * event.vx + event.vy * event.vy);
+                player.shots++;
+                player.shotSpeedSum += speed;
+                player.shotSpeedMax = std::max(player.shotSpeedMax, speed);
+            }
+            pointShots++;
+            break;
+
+        case MatchEventType::POINT_WON: {
+            if (event.player < 1 || event.player > 2) {
+                break;
+            }
+            PlayerStats& winner = stats.players[event.player - 1];
+            winner.pointsWon++;
+            // deuceSide es el lado de la pantalla del que saca. El jugador 2
+            // mira hacia abajo, asi que su lado de iguales es el izquierdo.
+            if (event.deuceSide == (server != 2)) {
+                winner.deuceSidePointsWon++;
+            }
+            else {
+                winner.adSidePointsWon++;
+            }
+
+            if (server >= 1 && server <= 2) {
+                PlayerStats& serving = stats.players[server - 1];
+                serving.servicePointsPlayed++;
+                if (event.player == server) {
+                    serving.servicePointsWon++;
+                }
+            }
+
+            stats.points++;
+            stats.rallyShots += pointShots;
+            stats.longestRally = std::max(stats.longestRally, pointShots);
+            pointShots = 0;
+            pointFaults = 0;
+            break;
+        }
+
+        case MatchEventType::GAME_WON:
+            stats.games++;
+            break;
+
+        case MatchEventType::SET_WON:
+            stats.sets++;
+            break;
+
+        case MatchEventType::BOUNCE:
+            break;
+        }
+    }
+
+    void MatchStatsAccumulator::reset() {
+        stats = MatchStats();
+        server = 0;
+        pointShots = 0;
+        pointFaults = 0;
+    }
+
+    const char* MatchStatsTable::getColumnName(int column) {
+        return column >= 0 && column < COLUMN_COUNT ? COLUMN_NAMES[column] : "";
+    }
+
+    MatchStatsTable::MatchStatsTable(size_t rowCapacity) {
+        for (auto& values : columns) {
+            values.reserve(rowCapacity);
+        }
+    }
+
+    void MatchStatsTable::append(uint64_t seed, uint64_t steps, int winner, const MatchStats& stats) {
+        columns[SEED].push_back(static_cast<double>(seed));
+        columns[STEPS].push_back(static_cast<double>(steps));
+        columns[WINNER].push_back(winner);
+        columns[POINTS].push_back(stats.points);
+        columns[GAMES].push_back(stats.games);
+        columns[SETS].push_back(stats.sets);
+        columns[RALLY_SHOTS].push_back(stats.rallyShots);
+        columns[LONGEST_RALLY].push_back(stats.longestRally);
+
+        for (int p = 0; p < 2; p++) {
+            const PlayerStats& player = stats.players[p];
+            int base = p == 0 ? PLAYER1_DOUBLE_FAULTS : PLAYER2_DOUBLE_FAULTS;
+            columns[base + 0].push_back(player.doubleFaults);
+            columns[base + 1].push_back(player.shots);
+            columns[base + 2].push_back(player.shots > 0 ? player.shotSpeedSum / player.shots : 0.0);
+            columns[base + 3].push_back(player.shotSpeedMax);
+            columns[base + 4].push_back(player.pointsWon);
+            columns[base + 5].push_back(player.deuceSidePointsWon);
+            columns[base + 6].push_back(player.adSidePointsWon);
+            columns[base + 7].push_back(player.servicePointsPlayed);
+            columns[base + 8].push_back(player.servicePointsWon);
+        }
+    }
+
+    void MatchStatsTable::clear() {
+        for (auto& values : columns) {
+            values.clear();
+        }
+    }
+
+    MatchStatsWriter::~MatchStatsWriter() {
+        close();
+    }
+
+    bool MatchStatsWriter::open(const std::string& path, Format newFormat) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) {
+            fclose(file);
+        }
+
+        format = newFormat;
+        file = fopen(path.c_str(), format == Format::BINARY ? "wb" : "w");
+        if (!file) {
+            return false;
+        }
+
+        if (format == Format::BINARY) {
+            uint32_t columnCount = MatchStatsTable::COLUMN_COUNT;
+            fwrite("MSB1", 1, 4, file);
+            fwrite(&columnCount, sizeof(columnCount), 1, file);
+            for (int c = 0; c < MatchStatsTable::COLUMN_COUNT; c++) {
+                const char* name = MatchStatsTable::getColumnName(c);
+                fwrite(name, 1, strlen(name) + 1, file);
+            }
+        }
+        else {
+            for (int c = 0; c < MatchStatsTable::COLUMN_COUNT; c++) {
+                fprintf(file, c == 0 ? "%s" : ",%s", MatchStatsTable::getColumnName(c));
+            }
+            fputc('\n', file);
+        }
+        return true;
+    }
+
+    void MatchStatsWriter::close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    void MatchStatsWriter::writeBatch(const MatchStatsTable& table) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file || table.rows() == 0) {
+            return;
+        }
+
+        if (format == Format::BINARY) {
+            uint32_t rowCount = static_cast<uint32_t>(table.rows());
+            fwrite(&rowCount, sizeof(rowCount), 1, file);
+            for (int c = 0; c < MatchStatsTable::COLUMN_COUNT; c++) {
+                fwrite(table.column(c).data(), sizeof(double), rowCount, file);
+            }
+            return;
+        }
+
+        for (size_t row = 0; row < table.rows(); row++) {
+            for (int c = 0; c < MatchStatsTable::COLUMN_COUNT; c++) {
+                fprintf(file, c == 0 ? "%.10g" : ",%.10g", table.column(c)[row]);
+            }
+            fputc('\n', file);
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef __MATCH_STATS_H__
+#define __MATCH_STATS_H__
+
+#include "MatchEvents.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    // No hay columna de aces: la pelota solo bota al acabar el punto, y un
+    // saque que nadie toca sale por el fondo y lo pierde el que saca.
+    struct PlayerStats {
+        uint32_t doubleFaults = 0;
+        uint32_t shots = 0;
+        uint32_t pointsWon = 0;
+        uint32_t deuceSidePointsWon = 0;
+        uint32_t adSidePointsWon = 0;
+        uint32_t servicePointsPlayed = 0;
+        uint32_t servicePointsWon = 0;
+        float shotSpeedSum = 0.0f;
+        float shotSpeedMax = 0.0f;
+    };
+
+    struct MatchStats {
+        PlayerStats players[2];
+        uint32_t points = 0;
+        uint32_t games = 0;
+        uint32_t sets = 0;
+        uint32_t rallyShots = 0;
+        uint32_t longestRally = 0;
+    };
+
+    // Acumula contadores de un partido a partir de los eventos del bus. Cada
+    // hilo tiene el suyo y va alineado a linea de cache para que dos hilos
+    // nunca escriban en la misma linea; no hay atomicos ni cerrojos.
+    class alignas(64) MatchStatsAccumulator {
+    public:
+        void onEvent(const MatchEvent& event);
+        void reset();
+
+        const MatchStats& getStats() const { return stats; }
+
+    private:
+        MatchStats stats;
+        int server = 0;
+        uint32_t pointShots = 0;
+        int pointFaults = 0;
+    };
+
+    // Filas de MatchStats guardadas por columnas (un vector por columna)
+    // para escribirlas en bloque.
+    class MatchStatsTable {
+    public:
+        enum Column {
+            SEED,
+            STEPS,
+            WINNER,
+            POINTS,
+            GAMES,
+            SETS,
+            RALLY_SHOTS,
+            LONGEST_RALLY,
+            PLAYER1_DOUBLE_FAULTS,
+            PLAYER1_SHOTS,
+            PLAYER1_AVG_SHOT_SPEED,
+            PLAYER1_MAX_SHOT_SPEED,
+            PLAYER1_POINTS_WON,
+            PLAYER1_DEUCE_SIDE_WON,
+            PLAYER1_AD_SIDE_WON,
+            PLAYER1_SERVICE_PLAYED,
+            PLAYER1_SERVICE_WON,
+            PLAYER2_DOUBLE_FAULTS,
+            PLAYER2_SHOTS,
+            PLAYER2_AVG_SHOT_SPEED,
+            PLAYER2_MAX_SHOT_SPEED,
+            PLAYER2_POINTS_WON,
+            PLAYER2_DEUCE_SIDE_WON,
+            PLAYER2_AD_SIDE_WON,
+            PLAYER2_SERVICE_PLAYED,
+            PLAYER2_SERVICE_WON,
+            COLUMN_COUNT
+        };
+
+        static const char* getColumnName(int column);
+
+        explicit MatchStatsTable(size_t rowCapacity = 0);
+
+        void append(uint64_t seed, uint64_t steps, int winner, const MatchStats& stats);
+        void clear();
+
+        size_t rows() const { return columns[SEED].size(); }
+        const std::vector<double>& column(int column) const { return columns[column]; }
+
+    private:
+        std::vector<double> columns[COLUMN_COUNT];
+    };
+
+    // Escribe tablas en CSV o en binario por columnas. Se llama con cada
+    // lote lleno, no en cada paso; el mutex solo serializa los lotes.
+    //
+    // Formato binario: "MSB1", uint32 columnas, nombres terminados en 0 y
+    // luego, por lote, uint32 filas seguido de cada columna como doubles.
+    class MatchStatsWriter {
+    public:
+        enum class Format {
+            CSV,
+            BINARY
+        };
+
+        ~MatchStatsWriter();
+
+        bool open(const std::string& path, Format format);
+        void close();
+        void writeBatch(const MatchStatsTable& table);
+
+    private:
+        std::mutex mutex;
+        FILE* file = nullptr;
+        Format format = Format::CSV;
+    };
+
+}
+
+#endif
\ No newline at end of file
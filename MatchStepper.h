@@ -0,0 +1,156 @@
+#ifndef __MATCH_STEPPER_H__
+#define __MATCH_STEPPER_H__
+
+#include "MatchEvents.h"
+#include "MatchReplay.h"
+#include "MatchSim.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace EpicGame {
+
+    // Politicas de control para MatchStepper. Cada una da el PlayerCommand
+    // de un jugador en el paso actual y dice de donde sale:
+    //   static constexpr MatchSim::CommandSource SOURCE;
+    //   MatchSim::PlayerCommand command(MatchSim& sim, int player);
+    // Se eligen como parametros de plantilla, asi que pedir los comandos no
+    // pasa por llamadas virtuales, y SOURCE elige en compilacion que campos
+    // del comando mira MatchSim::step<> para sacar. IA contra IA no lee
+    // swing en el saque ni traduce teclas; solo HumanPolicy lo hace.
+
+    // Teclado (o un agente que decide como si pulsara teclas).
+    struct HumanPolicy {
+        bool left = false;
+        bool right = false;
+        bool up = false;
+        bool down = false;
+        bool space = false;
+        ShotType shot = ShotType::NORMAL;
+
+        static constexpr MatchSim::CommandSource SOURCE = MatchSim::CommandSource::KEYBOARD;
+
+        MatchSim::PlayerCommand command(MatchSim&, int) const {
+            return MatchSim::keyboardCommand(left, right, up, down, space, shot);
+        }
+    };
+
+    // La IA de TennisScene::updateAI.
+    struct ScriptedAIPolicy {
+        static constexpr MatchSim::CommandSource SOURCE = MatchSim::CommandSource::SCRIPTED;
+
+        MatchSim::PlayerCommand command(MatchSim& sim, int player) const {
+            return sim.scriptedCommand(player);
+        }
+    };
+
+    // La misma IA con otros parametros (torneos de variantes).
+    struct ProfileAIPolicy {
+        MatchSim::AIProfile profile;
+
+        static constexpr MatchSim::CommandSource SOURCE = MatchSim::CommandSource::SCRIPTED;
+
+        MatchSim::PlayerCommand command(MatchSim& sim, int player) const {
+            return sim.scriptedCommand(player, profile);
+        }
+    };
+
+    // Comandos grabados en una MatchReplay, uno por paso.
+    class ReplayPlaybackPolicy {
+    public:
+        static constexpr MatchSim::CommandSource SOURCE = MatchSim::CommandSource::RECORDED;
+
+        ReplayPlaybackPolicy() = default;
+        explicit ReplayPlaybackPolicy(const MatchReplay& replay) : replay(&replay) {}
+
+        MatchSim::PlayerCommand command(MatchSim&, int player) {
+            const MatchReplay::Frame& recorded = replay->getFrame(frame++);
+            return player == 1 ? recorded.player1 : recorded.player2;
+        }
+
+        bool finished() const { return !replay || frame >= replay->size(); }
+
+    private:
+        const MatchReplay* replay = nullptr;
+        size_t frame = 0;
+    };
+
+    // Jugador remoto simulado en local: los comandos de Source pasan por una
+    // cola como la de la red y llegan LatencyFrames pasos tarde. Mientras no
+    // llega nada se repite el ultimo comando, como haria el cliente real.
+    template <typename Source, int LatencyFrames>
+    class LoopbackRemotePolicy {
+        static_assert(LatencyFrames >= 0 && LatencyFrames < 256, "LatencyFrames fuera de rango");
+
+    public:
+        // Con retraso llegan los mismos comandos de Source, solo que tarde.
+        static constexpr MatchSim::CommandSource SOURCE = Source::SOURCE;
+
+        LoopbackRemotePolicy() = default;
+        explicit LoopbackRemotePolicy(const Source& source) : source(source) {}
+
+        MatchSim::PlayerCommand command(MatchSim& sim, int player) {
+            if (channel.push(source.command(sim, player))) {
+                sent++;
+            }
+            if (sent - received > static_cast<uint64_t>(LatencyFrames) && channel.pop(last)) {
+                received++;
+            }
+            return last;
+        }
+
+        Source& getSource() { return source; }
+
+    private:
+        Source source;
+        SpscRing<MatchSim::PlayerCommand, 256> channel;
+        MatchSim::PlayerCommand last;
+        uint64_t sent = 0;
+        uint64_t received = 0;
+    };
+
+    // Paso de MatchSim con los comandos de dos politicas. LoopbackRemotePolicy
+    // no se puede copiar: se usa con el constructor de solo sim.
+    template <typename Player1Policy, typename Player2Policy>
+    class MatchStepper {
+    public:
+        explicit MatchStepper(MatchSim& sim) : sim(sim) {}
+        MatchStepper(MatchSim& sim, const Player1Policy& player1, const Player2Policy& player2)
+            : sim(sim), player1(player1), player2(player2) {}
+
+        MatchSim::StepResult step(float frameTime) {
+            player1Command = player1.command(sim, 1);
+            player2Command = player2.command(sim, 2);
+            return sim.step<Player1Policy::SOURCE, Player2Policy::SOURCE>(frameTime, player1Command, player2Command);
+        }
+
+        // MatchSim::beginStep/finishStep con los comandos de las politicas,
+        // para los llamadores que integran las pelotas por lotes.
+        bool beginStep(float frameTime, MatchSim::StepResult& result) {
+            player1Command = player1.command(sim, 1);
+            player2Command = player2.command(sim, 2);
+            return sim.beginStep<Player1Policy::SOURCE, Player2Policy::SOURCE>(frameTime, player1Command, player2Command,
+                result);
+        }
+
+        void finishStep(MatchSim::StepResult& result) {
+            sim.finishStep(player2Command, result);
+        }
+
+        MatchSim& getSim() { return sim; }
+        Player1Policy& getPlayer1() { return player1; }
+        Player2Policy& getPlayer2() { return player2; }
+        // Comandos usados en el ultimo paso (para grabar repeticiones).
+        const MatchSim::PlayerCommand& getPlayer1Command() const { return player1Command; }
+        const MatchSim::PlayerCommand& getPlayer2Command() const { return player2Command; }
+
+    private:
+        MatchSim& sim;
+        Player1Policy player1;
+        Player2Policy player2;
+        MatchSim::PlayerCommand player1Command;
+        MatchSim::PlayerCommand player2Command;
+    };
+
+}
+
+#endif
\ No newline at end of file
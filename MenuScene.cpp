@@ -1,5 +1,8 @@
 #include "MenuScene.h"
+#include "FramePacer.h"
 #include "TennisScene.h"
+#include "PracticeScene.h"
+#include "SpectatorScene.h"
 
 USING_NS_CC;
 
@@ -52,7 +55,25 @@ namespace EpicGame {
             CCLOG("Error: No se pudo crear el botn Start Game");
             return false;
         }
-        playItem->setPosition(Vec2(0, 50));
+        playItem->setPosition(Vec2(0, 100));
+
+        auto practiceItem = MenuItemLabel::create(
+            Label::createWithSystemFont("Practice", "Arial", 45),
+            CC_CALLBACK_1(MenuScene::menuPracticeCallback, this));
+        if (practiceItem == nullptr) {
+            CCLOG("Error: No se pudo crear el boton Practice");
+            return false;
+        }
+        practiceItem->setPosition(Vec2(0, 0));
+
+        auto spectatorItem = MenuItemLabel::create(
+            Label::createWithSystemFont("Spectator", "Arial", 45),
+            CC_CALLBACK_1(MenuScene::menuSpectatorCallback, this));
+        if (spectatorItem == nullptr) {
+            CCLOG("Error: No se pudo crear el boton Spectator");
+            return false;
+        }
+        spectatorItem->setPosition(Vec2(0, -100));
 
         auto exitItem = MenuItemLabel::create(
             Label::createWithSystemFont("Exit", "Arial", 45),
@@ -61,9 +82,9 @@ namespace EpicGame {
             CCLOG("Error: No se pudo crear el botn Exit");
             return false;
         }
-        exitItem->setPosition(Vec2(0, -150));
+        exitItem->setPosition(Vec2(0, -200));
 
-        auto menu = Menu::create(playItem, exitItem, nullptr);
+        auto menu = Menu::create(playItem, practiceItem, spectatorItem, exitItem, nullptr);
         if (menu == nullptr) {
             CCLOG("Error: No se pudo crear el men");
             return false;
@@ -74,6 +95,12 @@ namespace EpicGame {
         return true;
     }
 
+    void MenuScene::onEnterTransitionDidFinish() {
+        Scene::onEnterTransitionDidFinish();
+        // El menu no se mueve: solo se dibuja cuando hay entrada.
+        FramePacer::getInstance()->setActivity(FramePacer::Activity::STOPPED);
+    }
+
     void MenuScene::menuPlayCallback(Ref* pSender) {
         auto scene = TennisScene::createScene();
         if (scene == nullptr) {
@@ -83,6 +110,24 @@ namespace EpicGame {
         Director::getInstance()->replaceScene(TransitionFade::create(0.5f, scene));
     }
 
+    void MenuScene::menuPracticeCallback(Ref* pSender) {
+        auto scene = PracticeScene::createScene();
+        if (scene == nullptr) {
+            CCLOG("Error: No se pudo crear la escena de practica");
+            return;
+        }
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, scene));
+    }
+
+    void MenuScene::menuSpectatorCallback(Ref* pSender) {
+        auto scene = SpectatorScene::createScene();
+        if (scene == nullptr) {
+            CCLOG("Error: No se pudo crear la escena de espectador");
+            return;
+        }
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, scene));
+    }
+
     void MenuScene::menuExitCallback(Ref* pSender) {
         Director::getInstance()->end();
     }
@@ -9,11 +9,14 @@ namespace EpicGame {
     public:
         static cocos2d::Scene* createScene();
         virtual bool init();
+        void onEnterTransitionDidFinish() override;
 
         CREATE_FUNC(MenuScene);
 
     private:
         void menuPlayCallback(Ref* pSender);
+        void menuPracticeCallback(Ref* pSender);
+        void menuSpectatorCallback(Ref* pSender);
         void menuExitCallback(Ref* pSender);
     };
 
@@ -0,0 +1,241 @@
+#include "PointByPoint.h"
+#include <cstring>
+
+namespace EpicGame {
+
+    namespace {
+
+        // Recorre los campos de una linea CSV (con comillas) sin copiarlos.
+        // Devuelve el inicio de la linea siguiente.
+        template <typename OnField>
+        const char* scanRow(const char* position, const char* end, OnField&& onField) {
+            int column = 0;
+            while (position < end) {
+                const char* fieldBegin = position;
+                const char* fieldEnd;
+                if (*position == '"') {
+                    fieldBegin = ++position;
+                    while (position < end && !(*position == '"' && (position + 1 == end || position[1] != '"'))) {
+                        position += *position == '"' ? 2 : 1;
+                    }
+                    fieldEnd = position;
+                    position = position < end ? position + 1 : end;
+                    while (position < end && *position != ',' && *position != '\n') {
+                        position++;
+                    }
+                }
+                else {
+                    while (position < end && *position != ',' && *position != '\n') {
+                        position++;
+                    }
+                    fieldEnd = position;
+                    if (fieldEnd > fieldBegin && fieldEnd[-1] == '\r') {
+                        fieldEnd--;
+                    }
+                }
+
+                onField(column++, fieldBegin, fieldEnd);
+                if (position >= end) {
+                    return end;
+                }
+                if (*position++ == '\n') {
+                    return position;
+                }
+            }
+            return end;
+        }
+
+        bool fieldEquals(const char* begin, const char* end, const char* name) {
+            size_t length = strlen(name);
+            return static_cast<size_t>(end - begin) == length && memcmp(begin, name, length) == 0;
+        }
+
+    }
+
+    void PointByPointStats::merge(const PointByPointStats& other) {
+        matches += other.matches;
+        skippedRows += other.skippedRows;
+        points += other.points;
+        serverPoints += other.serverPoints;
+        aces += other.aces;
+        doubleFaults += other.doubleFaults;
+        games += other.games;
+        holds += other.holds;
+        tiebreaks += other.tiebreaks;
+        sets += other.sets;
+        gameMismatches += other.gameMismatches;
+        setMismatches += other.setMismatches;
+        matchMismatches += other.matchMismatches;
+    }
+
+    bool PointByPointReader::open(const std::string& path) {
+        rows = nullptr;
+        pbpColumn = winnerColumn = -1;
+        if (!file.open(path)) {
+            return false;
+        }
+
+        const char* end = file.data() + file.size();
+        rows = scanRow(file.data(), end, [this](int column, const char* begin, const char* fieldEnd) {
+            if (fieldEquals(begin, fieldEnd, "pbp")) {
+                pbpColumn = column;
+            }
+            else if (fieldEquals(begin, fieldEnd, "winner")) {
+                winnerColumn = column;
+            }
+        });
+
+        if (pbpColumn < 0) {
+            file.close();
+            rows = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    PointByPointStats PointByPointReader::run() const {
+        PointByPointStats stats;
+        if (!rows) {
+            return stats;
+        }
+
+        const char* end = file.data() + file.size();
+        const char* position = rows;
+        while (position < end) {
+            const char* pbpBegin = nullptr;
+            const char* pbpEnd = nullptr;
+            int winner = 0;
+            position = scanRow(position, end, [&](int column, const char* begin, const char* fieldEnd) {
+                if (column == pbpColumn) {
+                    pbpBegin = begin;
+                    pbpEnd = fieldEnd;
+                }
+                else if (column == winnerColumn && fieldEnd - begin == 1 && (*begin == '1' || *begin == '2')) {
+                    winner = *begin - '0';
+                }
+            });
+
+            if (pbpBegin == pbpEnd) {
+                stats.skippedRows++;
+                continue;
+            }
+            processMatch(pbpBegin, pbpEnd, winner, stats);
+        }
+        return stats;
+    }
+
+    void PointByPointReader::processMatch(const char* begin, const char* end, int matchWinner, PointByPointStats& stats) {
+        MatchScore score;
+        // MatchScore no tiene tie-break: esos juegos solo cuentan para las
+        // estadisticas y el marcador se ajusta a mano al terminar. Tras un
+        // juego que no cuadra tambien se ajusta, para seguir comparando.
+        bool tiebreak = false;
+        bool gameClosed = false;
+        int gameServer = score.servingPlayer;
+        int pointServer = gameServer;
+        int lastWinner = 0;
+        int setsBefore = 0;
+        bool pointsInGame = false;
+
+        auto endGame = [&](bool setEnd) {
+            stats.games++;
+            if (tiebreak) {
+                stats.tiebreaks++;
+            }
+            if (lastWinner == gameServer) {
+                stats.holds++;
+            }
+
+            if (!tiebreak && !gameClosed) {
+                stats.gameMismatches++;
+            }
+            if (tiebreak || !gameClosed) {
+                (lastWinner == 1 ? score.player1Games : score.player2Games)++;
+                score.player1Points = score.player2Points = 0;
+                score.isDeuce = false;
+            }
+
+            bool engineSetEnd = score.player1Sets + score.player2Sets != setsBefore;
+            if (setEnd) {
+                stats.sets++;
+                if (!engineSetEnd) {
+                    // Un set 7-6 no puede cerrarse sin tie-break; el resto es un fallo de reglas.
+                    if (!tiebreak) {
+                        stats.setMismatches++;
+                    }
+                    (lastWinner == 1 ? score.player1Sets : score.player2Sets)++;
+                    score.player1Games = score.player2Games = 0;
+                }
+            }
+            else if (engineSetEnd) {
+                stats.setMismatches++;
+            }
+
+            score.servingPlayer = gameServer;
+            score.switchServer();
+            gameServer = pointServer = score.servingPlayer;
+            setsBefore = score.player1Sets + score.player2Sets;
+            tiebreak = false;
+            gameClosed = false;
+            pointsInGame = false;
+        };
+
+        for (const char* position = begin; position < end; position++) {
+            switch (*position) {
+            case 'A':
+                stats.aces++;
+                [[fallthrough]];
+            case 'S':
+            case 'R':
+            case 'D': {
+                bool serverWon = *position == 'S' || *position == 'A';
+                if (*position == 'D') {
+                    stats.doubleFaults++;
+                }
+                stats.points++;
+                stats.serverPoints += serverWon ? 1 : 0;
+                lastWinner = serverWon ? pointServer : 3 - pointServer;
+                // En el tie-break el saque cambia tras el primer punto.
+                if (!pointsInGame && position + 1 < end && position[1] == '/') {
+                    tiebreak = true;
+                }
+                pointsInGame = true;
+
+                if (!tiebreak) {
+                    if (gameClosed) {
+                        // MatchScore dio el juego antes de tiempo.
+                        stats.gameMismatches++;
+                    }
+                    else {
+                        gameClosed = score.awardPoint(lastWinner == 1);
+                    }
+                }
+                break;
+            }
+            case '/':
+                pointServer = 3 - pointServer;
+                break;
+            case ';':
+                endGame(false);
+                break;
+            case '.':
+                endGame(true);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // El ultimo set no lleva '.'.
+        if (pointsInGame) {
+            endGame(true);
+        }
+
+        stats.matches++;
+        if (matchWinner != 0 && score.player1Sets != score.player2Sets &&
+            (score.player1Sets > score.player2Sets ? 1 : 2) != matchWinner) {
+            stats.matchMismatches++;
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef __POINT_BY_POINT_H__
+#define __POINT_BY_POINT_H__
+
+#include "MappedFile.h"
+#include "TennisRules.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace EpicGame {
+
+    // Totales de una pasada por datos punto a punto reales. Los *Mismatches
+    // son juegos, sets o partidos donde MatchScore no cierra en el mismo
+    // punto que el partido real.
+    struct PointByPointStats {
+        uint64_t matches = 0;
+        uint64_t skippedRows = 0;
+        uint64_t points = 0;
+        uint64_t serverPoints = 0;      // puntos ganados por el que saca
+        uint64_t aces = 0;
+        uint64_t doubleFaults = 0;
+        uint64_t games = 0;
+        uint64_t holds = 0;             // juegos ganados por el que saca
+        uint64_t tiebreaks = 0;
+        uint64_t sets = 0;
+        uint64_t gameMismatches = 0;
+        uint64_t setMismatches = 0;
+        uint64_t matchMismatches = 0;
+
+        double getServeWinRate() const { return points ? static_cast<double>(serverPoints) / points : 0.0; }
+        double getReturnWinRate() const { return points ? 1.0 - getServeWinRate() : 0.0; }
+        double getHoldRate() const { return games ? static_cast<double>(holds) / games : 0.0; }
+
+        void merge(const PointByPointStats& other);
+    };
+
+    // Lee CSV con el formato publico de tennis_pointbypoint: una fila por
+    // partido, con la columna "pbp" (S/A gana el que saca, R/D gana el que
+    // resta, ';' fin de juego, '.' fin de set, '/' cambio de saque en el
+    // tie-break) y "winner" (1 o 2, server1 saca primero). El fichero se
+    // mapea en memoria y cada secuencia pasa punto a punto por
+    // MatchScore::awardPoint sin reservar memoria por fila.
+    class PointByPointReader {
+    public:
+        bool open(const std::string& path);
+        void close() { file.close(); }
+
+        // Recorre todas las filas del fichero abierto.
+        PointByPointStats run() const;
+
+        // Una secuencia pbp completa; matchWinner es 1, 2 o 0 si no se sabe.
+        static void processMatch(const char* begin, const char* end, int matchWinner, PointByPointStats& stats);
+
+    private:
+        MappedFile file;
+        const char* rows = nullptr;     // primera fila despues de la cabecera
+        int pbpColumn = -1;
+        int winnerColumn = -1;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,367 @@
+#include "PracticeScene.h"
+#include "FramePacer.h"
+#include "MenuScene.h"
+#include <cstdio>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    Scene* PracticeScene::createScene() {
+        return PracticeScene::create();
+    }
+
+    bool PracticeScene::init() {
+        if (!Scene::init()) {
+            return false;
+        }
+
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+        courtGeometry = CourtGeometry::fromVisibleSize(visibleSize.width, visibleSize.height);
+        grid.reset(new SpatialGrid(visibleSize.width, visibleSize.height, GRID_CELL_SIZE, POOL_CAPACITY));
+        rng.seed(std::random_device()());
+
+        initCourt();
+        initPlayer();
+        initBallPool();
+        initLines();
+        initUI();
+
+        auto keyListener = EventListenerKeyboard::create();
+        keyListener->onKeyPressed = CC_CALLBACK_2(PracticeScene::onKeyPressed, this);
+        keyListener->onKeyReleased = CC_CALLBACK_2(PracticeScene::onKeyReleased, this);
+        _eventDispatcher->addEventListenerWithSceneGraphPriority(keyListener, this);
+
+        FramePacer::getInstance()->setActivity(FramePacer::Activity::NORMAL);
+        scheduleUpdate();
+        return true;
+    }
+
+    void PracticeScene::initCourt() {
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+
+        auto court = CourtDrawing::create(courtGeometry, visibleSize.height * 0.02f);
+        if (court) {
+            this->addChild(court, 0);
+        }
+    }
+
+    void PracticeScene::initPlayer() {
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+
+        player = Sprite::create("player1.png");
+        if (player) {
+            player->setScale(FRONT_PLAYER_SCALE);
+            player->setPosition(visibleSize.width * 0.5f, visibleSize.height * 0.2f);
+            this->addChild(player, 2);
+        }
+    }
+
+    void PracticeScene::initBallPool() {
+        ballBatch = SpriteBatchNode::create("ball.png", POOL_CAPACITY);
+        if (ballBatch == nullptr) {
+            CCLOG("Error: No se pudo cargar ball.png");
+            return;
+        }
+        this->addChild(ballBatch, 2);
+
+        ballSprites.reserve(POOL_CAPACITY);
+        for (int slot = 0; slot < POOL_CAPACITY; slot++) {
+            auto sprite = Sprite::createWithTexture(ballBatch->getTexture());
+            sprite->setScale(BALL_BASE_SCALE);
+            sprite->setVisible(false);
+            ballBatch->addChild(sprite);
+            ballSprites.push_back(sprite);
+        }
+
+        // Sombras como las de TennisScene::updateShadows, en su propio lote por
+        // debajo de las pelotas.
+        shadowBatch = SpriteBatchNode::create("ball_shadow.png", POOL_CAPACITY);
+        if (shadowBatch == nullptr) {
+            CCLOG("Error: No se pudo cargar ball_shadow.png");
+            return;
+        }
+        this->addChild(shadowBatch, 1);
+
+        shadowSprites.reserve(POOL_CAPACITY);
+        for (int slot = 0; slot < POOL_CAPACITY; slot++) {
+            auto shadow = Sprite::createWithTexture(shadowBatch->getTexture());
+            shadow->setColor(Color3B(0, 0, 0));
+            shadow->setOpacity(120);
+            shadow->setVisible(false);
+            shadowBatch->addChild(shadow);
+            shadowSprites.push_back(shadow);
+        }
+    }
+
+    void PracticeScene::initLines() {
+        float top = courtGeometry.height - courtGeometry.baselineOffset;
+        float bottom = courtGeometry.baselineOffset;
+        float margin = GRID_CELL_SIZE * 0.5f;
+
+        // Mismos limites (con perspectiva) que BallFlight::isOutOfCourt y las lineas dibujadas.
+        float bottomLeft = CourtDrawing::getSidelineX(courtGeometry, bottom, false);
+        float bottomRight = CourtDrawing::getSidelineX(courtGeometry, bottom, true);
+        float topLeft = CourtDrawing::getSidelineX(courtGeometry, top, false);
+        float topRight = CourtDrawing::getSidelineX(courtGeometry, top, true);
+
+        grid->addSegment(bottomLeft, bottom, topLeft, top, SIDELINE, margin);
+        grid->addSegment(bottomRight, bottom, topRight, top, SIDELINE, margin);
+        grid->addSegment(bottomLeft, bottom, bottomRight, bottom, NEAR_BASELINE, margin);
+        grid->addSegment(topLeft, top, topRight, top, FAR_BASELINE, margin);
+        grid->buildSegments();
+    }
+
+    void PracticeScene::initUI() {
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+
+        hudLabel = Label::createWithSystemFont("", "Arial", 24);
+        if (hudLabel) {
+            hudLabel->setPosition(Vec2(visibleSize.width - 220, visibleSize.height - 30));
+            hudLabel->setAlignment(TextHAlignment::RIGHT);
+            this->addChild(hudLabel, 3);
+        }
+
+        updateHud(HUD_INTERVAL);
+    }
+
+    void PracticeScene::update(float delta) {
+        updatePlayer(delta);
+        updateMachine(delta);
+
+        auto ballsStart = std::chrono::steady_clock::now();
+        updateBalls(delta);
+        hudBallsMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ballsStart).count();
+        hudFrames++;
+        hudWorstFrame = std::max(hudWorstFrame, delta);
+
+        updateHud(delta);
+    }
+
+    void PracticeScene::updatePlayer(float delta) {
+        if (!player) return;
+
+        Vec2 pos = player->getPosition();
+        float moveSpeed = PLAYER_SPEED * delta;
+
+        if (leftPressed) pos.x -= moveSpeed;
+        if (rightPressed) pos.x += moveSpeed;
+
+        float halfWidth = player->getContentSize().width * player->getScale() / 2;
+        float minX = (courtGeometry.width - courtGeometry.courtWidth) / 2 + halfWidth;
+        float maxX = (courtGeometry.width + courtGeometry.courtWidth) / 2 - halfWidth;
+
+        pos.x = std::min(std::max(pos.x, minX), maxX);
+        player->setPosition(pos);
+    }
+
+    void PracticeScene::updateMachine(float delta) {
+        fireTimer += delta;
+
+        if (stressMode) {
+            while (pool.getActiveCount() < STRESS_BALLS && pool.getActiveCount() < pool.getCapacity()) {
+                fireBall();
+            }
+            return;
+        }
+
+        while (fireTimer >= machine.interval) {
+            fireTimer -= machine.interval;
+            for (int i = 0; i < machine.ballsPerShot; i++) {
+                fireBall();
+            }
+        }
+    }
+
+    void PracticeScene::fireBall() {
+        float startX = machine.positionX * courtGeometry.width;
+        float startY = machine.positionY * courtGeometry.height;
+
+        std::uniform_real_distribution<float> spread(-0.5f, 0.5f);
+        float targetX = courtGeometry.width * 0.5f + spread(rng) * machine.spread * courtGeometry.courtWidth;
+        float targetY = courtGeometry.height * 0.2f;
+
+        Vec2 direction(targetX - startX, targetY - startY);
+        direction.normalize();
+
+        int slot = pool.spawn(startX, startY, direction.x * machine.speed, direction.y * machine.speed, 0);
+        if (slot >= 0 && slot < static_cast<int>(ballSprites.size())) {
+            placeBall(slot, startX, startY);
+            ballSprites[slot]->setVisible(true);
+            if (slot < static_cast<int>(shadowSprites.size())) {
+                shadowSprites[slot]->setVisible(true);
+            }
+        }
+    }
+
+    void PracticeScene::retireBall(int slot) {
+        pool.release(slot);
+        if (slot < static_cast<int>(ballSprites.size())) {
+            ballSprites[slot]->setVisible(false);
+        }
+        if (slot < static_cast<int>(shadowSprites.size())) {
+            shadowSprites[slot]->setVisible(false);
+        }
+    }
+
+    void PracticeScene::placeBall(int slot, float x, float y) {
+        ballSprites[slot]->setPosition(x, y);
+        if (slot >= static_cast<int>(shadowSprites.size())) {
+            return;
+        }
+
+        // Mas pequena en la mitad de arriba y sin salir de la pista.
+        float courtBottom = courtGeometry.height * 0.15f;
+        float courtTop = courtGeometry.height * 0.85f;
+        float scale = BALL_BASE_SCALE * (y > courtGeometry.height * 0.5f ? 0.6f : 0.8f);
+        shadowSprites[slot]->setPosition(x, std::min(std::max(y, courtBottom), courtTop));
+        shadowSprites[slot]->setScale(scale);
+    }
+
+    void PracticeScene::updateBalls(float delta) {
+        const int capacity = pool.getCapacity();
+
+        for (int slot = 0; slot < capacity; slot++) {
+            if (!pool.alive[slot]) {
+                continue;
+            }
+
+            BallState ball;
+            ball.x = pool.x[slot];
+            ball.y = pool.y[slot];
+            ball.vx = pool.vx[slot];
+            ball.vy = pool.vy[slot];
+            float oldX = ball.x;
+            float oldY = ball.y;
+
+            BallFlight::integrate(ball, delta);
+
+            int crossed = -1;
+            grid->querySegments(ball.x, ball.y, [&](const SpatialGrid::Segment& segment) {
+                if (crossed < 0 && SpatialGrid::crosses(segment, oldX, oldY, ball.x, ball.y)) {
+                    crossed = segment.kind;
+                }
+            });
+
+            bool offScreen = ball.x < 0.0f || ball.x > courtGeometry.width ||
+                ball.y < 0.0f || ball.y > courtGeometry.height;
+
+            if (crossed == SIDELINE) {
+                outCount++;
+                retireBall(slot);
+                continue;
+            }
+            if (crossed == NEAR_BASELINE && pool.lastHitter[slot] == 0) {
+                missedCount++;
+                retireBall(slot);
+                continue;
+            }
+            if (crossed == FAR_BASELINE && pool.lastHitter[slot] == 1) {
+                returnedCount++;
+                retireBall(slot);
+                continue;
+            }
+            if (offScreen) {
+                retireBall(slot);
+                continue;
+            }
+
+            pool.x[slot] = ball.x;
+            pool.y[slot] = ball.y;
+            pool.vx[slot] = ball.vx;
+            pool.vy[slot] = ball.vy;
+            placeBall(slot, ball.x, ball.y);
+        }
+
+        grid->build(pool.x.data(), pool.y.data(), pool.alive.data(), capacity);
+    }
+
+    void PracticeScene::hitBallsNearPlayer() {
+        if (!player) return;
+
+        Vec2 playerPos = player->getPosition();
+        Vec2 direction(0.0f, 1.0f);
+        if (leftPressed) direction.x -= 0.5f;
+        if (rightPressed) direction.x += 0.5f;
+        direction.normalize();
+
+        grid->queryItems(playerPos.x - HIT_RANGE_X, playerPos.y - HIT_RANGE_Y,
+            playerPos.x + HIT_RANGE_X, playerPos.y + HIT_RANGE_Y, [&](int slot) {
+                if (pool.lastHitter[slot] != 0 ||
+                    std::abs(pool.x[slot] - playerPos.x) >= HIT_RANGE_X ||
+                    std::abs(pool.y[slot] - playerPos.y) >= HIT_RANGE_Y) {
+                    return;
+                }
+                pool.vx[slot] = direction.x * HIT_BASE_SPEED;
+                pool.vy[slot] = direction.y * HIT_BASE_SPEED;
+                pool.lastHitter[slot] = 1;
+            });
+    }
+
+    void PracticeScene::updateHud(float delta) {
+        hudTimer += delta;
+        if (hudTimer < HUD_INTERVAL || !hudLabel) {
+            return;
+        }
+
+        std::string text = "In play: " + std::to_string(pool.getActiveCount()) +
+            "  Returned: " + std::to_string(returnedCount) +
+            "  Missed: " + std::to_string(missedCount) +
+            "  Out: " + std::to_string(outCount);
+        if (stressMode && hudFrames > 0) {
+            char timing[128];
+            snprintf(timing, sizeof(timing), "\nStress: %.1f fps  frame %.2f ms (worst %.2f)  balls %.2f ms",
+                hudFrames / hudTimer, hudTimer * 1000.0f / hudFrames, hudWorstFrame * 1000.0f,
+                hudBallsMs / hudFrames);
+            text += timing;
+        }
+        hudLabel->setString(text);
+
+        hudTimer = 0.0f;
+        hudFrames = 0;
+        hudWorstFrame = 0.0f;
+        hudBallsMs = 0.0;
+    }
+
+    void PracticeScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event) {
+        switch (keyCode) {
+        case EventKeyboard::KeyCode::KEY_LEFT_ARROW:
+            leftPressed = true;
+            break;
+        case EventKeyboard::KeyCode::KEY_RIGHT_ARROW:
+            rightPressed = true;
+            break;
+        case EventKeyboard::KeyCode::KEY_UP_ARROW:
+            machine.interval = std::max(machine.interval * 0.5f, 1.0f / 60.0f);
+            break;
+        case EventKeyboard::KeyCode::KEY_DOWN_ARROW:
+            machine.interval = std::min(machine.interval * 2.0f, 4.0f);
+            break;
+        case EventKeyboard::KeyCode::KEY_SPACE:
+            hitBallsNearPlayer();
+            break;
+        case EventKeyboard::KeyCode::KEY_S:
+            stressMode = !stressMode;
+            break;
+        case EventKeyboard::KeyCode::KEY_ESCAPE:
+            Director::getInstance()->replaceScene(TransitionFade::create(0.5f, MenuScene::createScene()));
+            break;
+        default:
+            break;
+        }
+    }
+
+    void PracticeScene::onKeyReleased(EventKeyboard::KeyCode keyCode, Event* event) {
+        switch (keyCode) {
+        case EventKeyboard::KeyCode::KEY_LEFT_ARROW:
+            leftPressed = false;
+            break;
+        case EventKeyboard::KeyCode::KEY_RIGHT_ARROW:
+            rightPressed = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef __PRACTICE_SCENE_H__
+#define __PRACTICE_SCENE_H__
+
+#include "cocos2d.h"
+#include "BallFlight.h"
+#include "BallPool.h"
+#include "CourtDrawing.h"
+#include "SpatialGrid.h"
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace EpicGame {
+
+    // Modo practica: una maquina lanza pelotas a player1. Las pelotas salen de
+    // un pool fijo de sprites y huecos de fisica, y los choques con el jugador
+    // y las lineas pasan por una rejilla uniforme. Con S se activa la prueba de
+    // carga de STRESS_BALLS pelotas en vuelo; mientras dura, el HUD muestra
+    // fps, ms por frame (media y peor) y ms de CPU de updateBalls.
+    class PracticeScene : public cocos2d::Scene {
+    public:
+        static cocos2d::Scene* createScene();
+        virtual bool init();
+        CREATE_FUNC(PracticeScene);
+
+        struct MachineConfig {
+            float positionX = 0.5f;       // normalizado al ancho visible
+            float positionY = 0.85f;      // normalizado al alto visible
+            float interval = 0.6f;
+            float speed = 550.0f;
+            float spread = 0.6f;          // fraccion del ancho de pista
+            int ballsPerShot = 1;
+        };
+
+    private:
+        static const int POOL_CAPACITY = 512;
+        static const int STRESS_BALLS = 500;
+
+        const float PLAYER_SPEED = 400.0f;
+        const float HIT_BASE_SPEED = 500.0f;
+        const float FRONT_PLAYER_SCALE = 0.4f;
+        const float BALL_BASE_SCALE = 0.05f;
+        const float HIT_RANGE_X = 100.0f;
+        const float HIT_RANGE_Y = 120.0f;
+        const float GRID_CELL_SIZE = 64.0f;
+        const float HUD_INTERVAL = 0.25f;
+
+        enum LineKind {
+            SIDELINE,
+            NEAR_BASELINE,
+            FAR_BASELINE
+        };
+
+        cocos2d::Sprite* player = nullptr;
+        cocos2d::SpriteBatchNode* ballBatch = nullptr;
+        cocos2d::SpriteBatchNode* shadowBatch = nullptr;
+        std::vector<cocos2d::Sprite*> ballSprites;
+        std::vector<cocos2d::Sprite*> shadowSprites;
+        cocos2d::Label* hudLabel = nullptr;
+
+        BallPool pool{ POOL_CAPACITY };
+        std::unique_ptr<SpatialGrid> grid;
+        CourtGeometry courtGeometry;
+        MachineConfig machine;
+        std::minstd_rand rng;
+
+        float fireTimer = 0.0f;
+        float hudTimer = 0.0f;
+        bool stressMode = false;
+        int returnedCount = 0;
+        int missedCount = 0;
+        int outCount = 0;
+
+        // Medida de la prueba de carga, por intervalo de HUD.
+        int hudFrames = 0;
+        float hudWorstFrame = 0.0f;
+        double hudBallsMs = 0.0;
+
+        bool leftPressed = false;
+        bool rightPressed = false;
+
+        void initCourt();
+        void initPlayer();
+        void initBallPool();
+        void initLines();
+        void initUI();
+
+        void update(float delta) override;
+        void updatePlayer(float delta);
+        void updateMachine(float delta);
+        void updateBalls(float delta);
+        void updateHud(float delta);
+        void hitBallsNearPlayer();
+        void fireBall();
+        void retireBall(int slot);
+        void placeBall(int slot, float x, float y);
+
+        void onKeyPressed(cocos2d::EventKeyboard::KeyCode keyCode, cocos2d::Event* event);
+        void onKeyReleased(cocos2d::EventKeyboard::KeyCode keyCode, cocos2d::Event* event);
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "RenderStats.h"
+#include "CrowdLayer.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        // Los oyentes de teclado de RenderStats van antes y despues de todos los demas.
+        const int EVENT_PRIORITY = 1000000;
+        const int OVERLAY_INTERVAL = 15;    // frames entre refrescos del panel
+
+    }
+
+    RenderStats* RenderStats::getInstance() {
+        static RenderStats instance;
+        return &instance;
+    }
+
+    const char* RenderStats::getMetricName(Metric metric) {
+        switch (metric) {
+        case EVENT_MS: return "event_ms";
+        case UPDATE_MS: return "update_ms";
+        case VISIT_MS: return "visit_ms";
+        case RENDER_MS: return "render_ms";
+        case FRAME_MS: return "frame_ms";
+        case DRAW_CALLS: return "draw_calls";
+        case VERTICES: return "vertices";
+        case BATCHED_QUADS: return "batched_quads";
+        case UNBATCHED_QUADS: return "unbatched_quads";
+        case TEXTURE_SWITCHES: return "texture_switches";
+        case NODES_VISITED: return "nodes_visited";
+        default: return "unknown";
+        }
+    }
+
+    RenderStats::RenderStartMarker* RenderStats::RenderStartMarker::create(RenderStats* stats) {
+        auto marker = new (std::nothrow) RenderStartMarker();
+        if (marker && marker->init()) {
+            marker->stats = stats;
+            marker->autorelease();
+            return marker;
+        }
+        delete marker;
+        return nullptr;
+    }
+
+    void RenderStats::RenderStartMarker::draw(Renderer* renderer, const Mat4& transform, uint32_t flags) {
+        command.init(std::numeric_limits<float>::lowest());
+        command.func = [this] { stats->renderStart = utils::gettime(); };
+        renderer->addCommand(&command);
+    }
+
+    void RenderStats::install() {
+        if (installed) {
+            return;
+        }
+        installed = true;
+        history.resize(HISTORY_FRAMES);
+
+        auto director = Director::getInstance();
+        auto dispatcher = director->getEventDispatcher();
+        dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) { onBeforeUpdate(); });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [this](EventCustom*) { onAfterUpdate(); });
+        dispatcher->addCustomEventListener(Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { onBeforeDraw(); });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) { onAfterVisit(); });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { onAfterDraw(); });
+
+        auto first = EventListenerKeyboard::create();
+        first->onKeyPressed = [this](EventKeyboard::KeyCode, Event*) { eventStart = utils::gettime(); };
+        first->onKeyReleased = first->onKeyPressed;
+        dispatcher->addEventListenerWithFixedPriority(first, -EVENT_PRIORITY);
+
+        auto last = EventListenerKeyboard::create();
+        last->onKeyPressed = [this](EventKeyboard::KeyCode keyCode, Event*) {
+            eventTime += utils::gettime() - eventStart;
+            if (keyCode == EventKeyboard::KeyCode::KEY_F3) {
+                setOverlayVisible(!overlayVisible);
+            }
+            else if (keyCode == EventKeyboard::KeyCode::KEY_F2) {
+                std::string path = FileUtils::getInstance()->getWritablePath() +
+                    "render_stats_" + std::to_string(frameIndex) + ".csv";
+                if (dumpCSV(path)) {
+                    CCLOG("Estadisticas de render guardadas en %s", path.c_str());
+                }
+                else {
+                    CCLOG("Error: No se pudo guardar %s", path.c_str());
+                }
+            }
+        };
+        last->onKeyReleased = [this](EventKeyboard::KeyCode, Event*) { eventTime += utils::gettime() - eventStart; };
+        dispatcher->addEventListenerWithFixedPriority(last, EVENT_PRIORITY);
+
+        marker = RenderStartMarker::create(this);
+        CC_SAFE_RETAIN(marker);
+    }
+
+    void RenderStats::setOverlayVisible(bool visible) {
+        overlayVisible = visible;
+        if (visible && !overlay) {
+            // Nodo de notificacion: se dibuja encima de cualquier escena.
+            overlay = Label::createWithSystemFont("", "Arial", 16);
+            if (!overlay) {
+                CCLOG("Error: No se pudo crear el panel de estadisticas");
+                overlayVisible = false;
+                return;
+            }
+            overlay->setAnchorPoint(Vec2(0.0f, 1.0f));
+            auto visibleSize = Director::getInstance()->getVisibleSize();
+            overlay->setPosition(Vec2(10, visibleSize.height - 60));
+            Director::getInstance()->setNotificationNode(overlay);
+            overlayCountdown = 0;
+        }
+        if (overlay) {
+            overlay->setVisible(visible);
+        }
+    }
+
+    void RenderStats::onBeforeUpdate() {
+        lastUpdateStart = updateStart;
+        updateStart = utils::gettime();
+    }
+
+    void RenderStats::onAfterUpdate() {
+        current.values[UPDATE_MS] = static_cast<float>((utils::gettime() - updateStart) * 1000.0);
+    }
+
+    void RenderStats::onBeforeDraw() {
+        auto director = Director::getInstance();
+        Scene* scene = director->getRunningScene();
+        if (marker && scene && marker->getParent() != scene) {
+            marker->removeFromParent();
+            scene->addChild(marker);
+        }
+
+        batchesBefore = director->getRenderer()->getDrawnBatches();
+        verticesBefore = director->getRenderer()->getDrawnVertices();
+        drawStart = utils::gettime();
+        renderStart = 0.0;
+    }
+
+    void RenderStats::onAfterVisit() {
+        double now = utils::gettime();
+        // Sin marcador (primer frame de una escena) todo cuenta como visita.
+        double split = renderStart >= drawStart ? renderStart : now;
+        current.values[VISIT_MS] = static_cast<float>((split - drawStart) * 1000.0);
+        current.values[RENDER_MS] = static_cast<float>((now - split) * 1000.0);
+
+        auto director = Director::getInstance();
+        current.values[DRAW_CALLS] = static_cast<float>(director->getRenderer()->getDrawnBatches() - batchesBefore);
+        current.values[VERTICES] = static_cast<float>(director->getRenderer()->getDrawnVertices() - verticesBefore);
+
+        // El recorrido para contar nodos no entra en los tiempos.
+        current.values[NODES_VISITED] = 0.0f;
+        current.values[BATCHED_QUADS] = 0.0f;
+        current.values[UNBATCHED_QUADS] = 0.0f;
+        current.values[TEXTURE_SWITCHES] = 0.0f;
+        lastTexture = 0;
+        if (Scene* scene = director->getRunningScene()) {
+            countNodes(scene, nullptr);
+        }
+        renderResume = utils::gettime();
+    }
+
+    void RenderStats::countNodes(Node* node, Node* parent) {
+        if (!node->isVisible()) {
+            return;
+        }
+        current.values[NODES_VISITED]++;
+
+        auto useTexture = [this](Texture2D* texture) {
+            GLuint name = texture ? texture->getName() : 0;
+            if (name != lastTexture) {
+                current.values[TEXTURE_SWITCHES]++;
+                lastTexture = name;
+            }
+        };
+
+        if (auto sprite = dynamic_cast<Sprite*>(node)) {
+            if (dynamic_cast<SpriteBatchNode*>(parent)) {
+                current.values[BATCHED_QUADS]++;
+            }
+            else {
+                current.values[UNBATCHED_QUADS]++;
+                useTexture(sprite->getTexture());
+            }
+        }
+        else if (auto batch = dynamic_cast<SpriteBatchNode*>(node)) {
+            useTexture(batch->getTexture());
+        }
+        else if (auto crowd = dynamic_cast<CrowdLayer*>(node)) {
+            current.values[BATCHED_QUADS] += crowd->getSpectatorCount();
+            current.values[TEXTURE_SWITCHES]++;
+            lastTexture = 0;
+        }
+        else if (dynamic_cast<Label*>(node)) {
+            // Cada etiqueta de fuente del sistema tiene su propia textura.
+            current.values[TEXTURE_SWITCHES]++;
+            lastTexture = 0;
+        }
+
+        for (Node* child : node->getChildren()) {
+            countNodes(child, node);
+        }
+    }
+
+    void RenderStats::onAfterDraw() {
+        double now = utils::gettime();
+        current.values[RENDER_MS] += static_cast<float>((now - renderResume) * 1000.0);
+        current.values[EVENT_MS] = static_cast<float>(eventTime * 1000.0);
+        current.values[FRAME_MS] = lastUpdateStart > 0.0 ? static_cast<float>((updateStart - lastUpdateStart) * 1000.0) : 0.0f;
+        eventTime = 0.0;
+
+        current.index = frameIndex++;
+        lastFrame = current;
+        history[historyNext] = current;
+        historyNext = (historyNext + 1) % history.size();
+        historyCount = std::min(historyCount + 1, history.size());
+
+        if (overlayVisible && --overlayCountdown <= 0) {
+            overlayCountdown = OVERLAY_INTERVAL;
+            updateOverlay();
+        }
+    }
+
+    float RenderStats::getPercentile(Metric metric, float percentile) const {
+        if (historyCount == 0) {
+            return 0.0f;
+        }
+        std::vector<float> values(historyCount);
+        for (size_t i = 0; i < historyCount; i++) {
+            values[i] = history[i].values[metric];
+        }
+        size_t rank = static_cast<size_t>(std::min(std::max(percentile, 0.0f), 1.0f) * (historyCount - 1) + 0.5f);
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    bool RenderStats::dumpCSV(const std::string& path) const {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+
+        fprintf(file, "frame");
+        for (int metric = 0; metric < METRIC_COUNT; metric++) {
+            fprintf(file, ",%s", getMetricName(static_cast<Metric>(metric)));
+        }
+        fprintf(file, "\n");
+
+        // Del mas antiguo al mas reciente.
+        size_t oldest = historyCount < history.size() ? 0 : historyNext;
+        for (size_t i = 0; i < historyCount; i++) {
+            const Frame& frame = history[(oldest + i) % history.size()];
+            fprintf(file, "%u", frame.index);
+            for (int metric = 0; metric < METRIC_COUNT; metric++) {
+                fprintf(file, ",%.3f", frame.values[metric]);
+            }
+            fprintf(file, "\n");
+        }
+
+        return fclose(file) == 0;
+    }
+
+    void RenderStats::updateOverlay() {
+        if (!overlay) {
+            return;
+        }
+
+        std::string text;
+        char line[96];
+        for (int metric = 0; metric < METRIC_COUNT; metric++) {
+            Metric m = static_cast<Metric>(metric);
+            snprintf(line, sizeof(line), "%-17s %8.2f  p50 %8.2f  p99 %8.2f\n", getMetricName(m),
+                lastFrame.values[m], getPercentile(m, 0.5f), getPercentile(m, 0.99f));
+            text += line;
+        }
+        overlay->setString(text);
+    }
+
+}
\ No newline at end of file
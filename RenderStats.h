@@ -0,0 +1,105 @@
+#ifndef __RENDER_STATS_H__
+#define __RENDER_STATS_H__
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    // Contadores por frame de la parte de render, ademas de los de
+    // setDisplayStats: llamadas de dibujo, quads en lotes y sueltos, cambios
+    // de textura, nodos visitados y tiempo de CPU repartido entre eventos de
+    // teclado, update, visita de la escena y render. Guarda HISTORY_FRAMES
+    // frames para p50/p99 y volcado a CSV. F3 muestra u oculta el panel.
+    class RenderStats {
+    public:
+        enum Metric {
+            EVENT_MS,
+            UPDATE_MS,
+            VISIT_MS,
+            RENDER_MS,
+            FRAME_MS,           // del inicio de un update al del siguiente
+            DRAW_CALLS,
+            VERTICES,
+            BATCHED_QUADS,      // hijos de SpriteBatchNode y quads del publico
+            UNBATCHED_QUADS,    // Sprites sueltos
+            TEXTURE_SWITCHES,   // estimado: cambios de textura en orden de dibujo
+            NODES_VISITED,
+            METRIC_COUNT
+        };
+
+        struct Frame {
+            uint32_t index = 0;
+            float values[METRIC_COUNT] = {};
+        };
+
+        static const int HISTORY_FRAMES = 600;
+
+        static RenderStats* getInstance();
+        static const char* getMetricName(Metric metric);
+
+        // Se engancha a los eventos del Director; una vez, tras crear la vista.
+        void install();
+
+        void setOverlayVisible(bool visible);
+        bool isOverlayVisible() const { return overlayVisible; }
+
+        const Frame& getLastFrame() const { return lastFrame; }
+        size_t getHistorySize() const { return historyCount; }
+        // percentile en [0, 1] sobre los frames guardados.
+        float getPercentile(Metric metric, float percentile) const;
+        bool dumpCSV(const std::string& path) const;
+
+    private:
+        RenderStats() = default;
+
+        // Nodo que encola un comando antes que todos los de la escena: cuando
+        // se ejecuta, la visita ha terminado y empieza el render.
+        class RenderStartMarker : public cocos2d::Node {
+        public:
+            static RenderStartMarker* create(RenderStats* stats);
+            void draw(cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t flags) override;
+
+        private:
+            RenderStats* stats = nullptr;
+            cocos2d::CustomCommand command;
+        };
+
+        void onBeforeUpdate();
+        void onAfterUpdate();
+        void onBeforeDraw();
+        void onAfterVisit();
+        void onAfterDraw();
+        void countNodes(cocos2d::Node* node, cocos2d::Node* parent);
+        void updateOverlay();
+
+        bool installed = false;
+        bool overlayVisible = false;
+        RenderStartMarker* marker = nullptr;
+        cocos2d::Label* overlay = nullptr;
+
+        Frame current;
+        Frame lastFrame;
+        std::vector<Frame> history;
+        size_t historyCount = 0;
+        size_t historyNext = 0;
+        uint32_t frameIndex = 0;
+
+        double updateStart = 0.0;
+        double lastUpdateStart = 0.0;
+        double drawStart = 0.0;
+        double renderStart = 0.0;
+        double renderResume = 0.0;
+        double eventStart = 0.0;
+        double eventTime = 0.0;
+        ssize_t batchesBefore = 0;
+        ssize_t verticesBefore = 0;
+        GLuint lastTexture = 0;
+        int overlayCountdown = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
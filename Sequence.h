@@ -0,0 +1,179 @@
+#ifndef __SEQUENCE_H__
+#define __SEQUENCE_H__
+
+#include <coroutine>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace EpicGame {
+
+    class SequenceScheduler;
+
+    // Corrutina (C++20) para secuencias de juego: saque, falta, pausa tras el
+    // punto... Se escribe como codigo lineal con co_await y la reanuda un
+    // SequenceScheduler. Mientras espera no cuesta nada por frame salvo
+    // comparar su hora de despertar.
+    class Sequence {
+    public:
+        struct promise_type {
+            double wakeTime = 0.0;
+            std::function<bool()> condition;
+
+            Sequence get_return_object() { return Sequence(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::abort(); }
+        };
+
+        typedef std::coroutine_handle<promise_type> Handle;
+
+        Sequence() = default;
+        Sequence(Sequence&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Sequence& operator=(Sequence&& other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+        Sequence(const Sequence&) = delete;
+        Sequence& operator=(const Sequence&) = delete;
+        ~Sequence() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        bool done() const { return !handle || handle.done(); }
+
+    private:
+        friend class SequenceScheduler;
+        explicit Sequence(Handle handle) : handle(handle) {}
+
+        Handle handle;
+    };
+
+    // Reanuda las secuencias cuya espera ha terminado. Una secuencia puede
+    // arrancar o cancelar otras (incluida ella misma) desde dentro: los
+    // cambios se aplican al terminar tick().
+    class SequenceScheduler {
+    public:
+        // co_await nextFrame(): sigue en el siguiente tick; devuelve su delta.
+        struct NextFrame {
+            SequenceScheduler& scheduler;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(Sequence::Handle handle) const noexcept {
+                handle.promise().wakeTime = scheduler.time;
+                handle.promise().condition = nullptr;
+            }
+            float await_resume() const noexcept { return scheduler.delta; }
+        };
+
+        // co_await delay(s): duerme s segundos sin reanudarse entre medias.
+        struct Delay {
+            SequenceScheduler& scheduler;
+            float seconds;
+            bool await_ready() const noexcept { return seconds <= 0.0f; }
+            void await_suspend(Sequence::Handle handle) const noexcept {
+                handle.promise().wakeTime = scheduler.time + seconds;
+                handle.promise().condition = nullptr;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        // co_await until(f): se comprueba f() en cada tick y sigue en el
+        // primero que devuelve true; devuelve el delta de ese tick.
+        struct Until {
+            SequenceScheduler& scheduler;
+            std::function<bool()> condition;
+            bool await_ready() const { return condition(); }
+            void await_suspend(Sequence::Handle handle) {
+                handle.promise().wakeTime = scheduler.time;
+                handle.promise().condition = std::move(condition);
+            }
+            float await_resume() const noexcept { return scheduler.delta; }
+        };
+
+        NextFrame nextFrame() { return NextFrame{ *this }; }
+        Delay delay(float seconds) { return Delay{ *this, seconds }; }
+        Until until(std::function<bool()> condition) { return Until{ *this, std::move(condition) }; }
+
+        // Ejecuta la secuencia hasta su primer co_await y la deja en espera.
+        void start(Sequence sequence) {
+            sequence.handle.resume();
+            if (sequence.done()) {
+                return;
+            }
+            (ticking ? added : tasks).push_back(Task{ std::move(sequence), false });
+        }
+
+        void cancelAll() {
+            added.clear();
+            if (ticking) {
+                for (Task& task : tasks) {
+                    task.cancelled = true;
+                }
+            }
+            else {
+                tasks.clear();
+            }
+        }
+
+        void tick(float frameDelta) {
+            delta = frameDelta;
+            time += frameDelta;
+            ticking = true;
+
+            for (size_t i = 0; i < tasks.size(); i++) {
+                Task& task = tasks[i];
+                if (task.cancelled || task.sequence.done()) {
+                    continue;
+                }
+                Sequence::promise_type& promise = task.sequence.handle.promise();
+                if (promise.wakeTime > time || (promise.condition && !promise.condition())) {
+                    continue;
+                }
+                task.sequence.handle.resume();
+            }
+
+            ticking = false;
+            size_t kept = 0;
+            for (size_t i = 0; i < tasks.size(); i++) {
+                if (!tasks[i].cancelled && !tasks[i].sequence.done()) {
+                    if (kept != i) {
+                        tasks[kept] = std::move(tasks[i]);
+                    }
+                    kept++;
+                }
+            }
+            tasks.resize(kept);
+            for (Task& task : added) {
+                tasks.push_back(std::move(task));
+            }
+            added.clear();
+        }
+
+        bool empty() const { return tasks.empty() && added.empty(); }
+        float getDelta() const { return delta; }
+
+    private:
+        struct Task {
+            Sequence sequence;
+            bool cancelled;
+        };
+
+        std::vector<Task> tasks;
+        std::vector<Task> added;
+        double time = 0.0;
+        float delta = 0.0f;
+        bool ticking = false;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "ShotTable.h"
+#include <algorithm>
+
+namespace EpicGame {
+
+    ShotTable* ShotTable::getInstance() {
+        static ShotTable instance;
+        return &instance;
+    }
+
+    ShotTable::~ShotTable() {
+        unload();
+    }
+
+    bool ShotTable::load(const std::string& path) {
+        unload();
+        if (!file.open(path)) {
+            return false;
+        }
+
+        const size_t expectedSize = sizeof(Header) + sizeof(Entry) * ENTRY_COUNT;
+        const Header* header = reinterpret_cast<const Header*>(file.data());
+        if (file.size() != expectedSize ||
+            header->magic != MAGIC ||
+            header->version != VERSION ||
+            header->entryCount != static_cast<uint32_t>(ENTRY_COUNT) ||
+            header->dims[0] != BALL_X_BINS ||
+            header->dims[1] != BALL_Y_BINS ||
+            header->dims[2] != VEL_X_BINS ||
+            header->dims[3] != VEL_Y_BINS ||
+            header->dims[4] != AI_X_BINS ||
+            header->targetBins != TARGET_BINS ||
+            header->speedBins != SPEED_BINS) {
+            unload();
+            return false;
+        }
+
+        entries = reinterpret_cast<const Entry*>(file.data() + sizeof(Header));
+        return true;
+    }
+
+    void ShotTable::unload() {
+        entries = nullptr;
+        file.close();
+    }
+
+    bool ShotTable::lookup(float ballX, float ballY, float velX, float velY, float aiX,
+        float& targetX, float& speed) const {
+        if (entries == nullptr) {
+            return false;
+        }
+
+        int index = indexFor(
+            quantize(ballX, MIN_X, MAX_X, BALL_X_BINS),
+            quantize(ballY, MIN_BALL_Y, MAX_BALL_Y, BALL_Y_BINS),
+            quantize(velX, -MAX_VEL_X, MAX_VEL_X, VEL_X_BINS),
+            quantize(velY, MIN_VEL_Y, MAX_VEL_Y, VEL_Y_BINS),
+            quantize(aiX, MIN_X, MAX_X, AI_X_BINS));
+
+        const Entry& entry = entries[index];
+        targetX = targetForBin(entry.target);
+        speed = speedForBin(entry.speed);
+        return true;
+    }
+
+    int ShotTable::indexFor(int ballX, int ballY, int velX, int velY, int aiX) {
+        return (((ballX * BALL_Y_BINS + ballY) * VEL_X_BINS + velX) * VEL_Y_BINS + velY) * AI_X_BINS + aiX;
+    }
+
+    int ShotTable::quantize(float value, float minValue, float maxValue, int bins) {
+        int bin = static_cast<int>((value - minValue) / (maxValue - minValue) * bins);
+        return std::min(std::max(bin, 0), bins - 1);
+    }
+
+    float ShotTable::binCenter(int bin, float minValue, float maxValue, int bins) {
+        return minValue + (maxValue - minValue) * (bin + 0.5f) / bins;
+    }
+
+    float ShotTable::targetForBin(int bin) {
+        return binCenter(bin, MIN_X, MAX_X, TARGET_BINS);
+    }
+
+    float ShotTable::speedForBin(int bin) {
+        return MIN_SPEED + (MAX_SPEED - MIN_SPEED) * bin / (SPEED_BINS - 1);
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __SHOT_TABLE_H__
+#define __SHOT_TABLE_H__
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace EpicGame {
+
+    // Tabla precalculada por Tools/ShotTableBuilder con la mejor devolucion de
+    // la IA para cada estado discretizado de la pelota entrante. El fichero se
+    // mapea en memoria una sola vez y se comparte entre todos los partidos.
+    class ShotTable {
+    public:
+        static const uint32_t MAGIC = 0x31425453; // "STB1"
+        static const uint32_t VERSION = 1;
+
+        static const int BALL_X_BINS = 16;
+        static const int BALL_Y_BINS = 4;
+        static const int VEL_X_BINS = 4;
+        static const int VEL_Y_BINS = 4;
+        static const int AI_X_BINS = 16;
+        static const int ENTRY_COUNT = BALL_X_BINS * BALL_Y_BINS * VEL_X_BINS * VEL_Y_BINS * AI_X_BINS;
+
+        static const int TARGET_BINS = 16;
+        static const int SPEED_BINS = 4;
+
+        // Rangos normalizados al tamano visible (posiciones) y en pixeles/s (velocidades).
+        static constexpr float MIN_X = 0.1f;
+        static constexpr float MAX_X = 0.9f;
+        static constexpr float MIN_BALL_Y = 0.7f;
+        static constexpr float MAX_BALL_Y = 0.95f;
+        static constexpr float MAX_VEL_X = 600.0f;
+        static constexpr float MIN_VEL_Y = -200.0f;
+        static constexpr float MAX_VEL_Y = 1000.0f;
+        static constexpr float MIN_SPEED = 450.0f;
+        static constexpr float MAX_SPEED = 750.0f;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint8_t dims[5];
+            uint8_t targetBins;
+            uint8_t speedBins;
+            uint8_t reserved;
+        };
+
+        struct Entry {
+            uint8_t target;
+            uint8_t speed;
+        };
+
+        static ShotTable* getInstance();
+
+        bool load(const std::string& path);
+        void unload();
+        bool isLoaded() const { return entries != nullptr; }
+
+        // Consulta con coordenadas normalizadas (0..1) y velocidad en pixeles/s.
+        // Devuelve false si la tabla no esta cargada.
+        bool lookup(float ballX, float ballY, float velX, float velY, float aiX,
+            float& targetX, float& speed) const;
+
+        static int indexFor(int ballX, int ballY, int velX, int velY, int aiX);
+        static int quantize(float value, float minValue, float maxValue, int bins);
+        static float binCenter(int bin, float minValue, float maxValue, int bins);
+        static float targetForBin(int bin);
+        static float speedForBin(int bin);
+
+    private:
+        ShotTable() = default;
+        ~ShotTable();
+        ShotTable(const ShotTable&) = delete;
+        ShotTable& operator=(const ShotTable&) = delete;
+
+        const Entry* entries = nullptr;
+        MappedFile file;
+    };
+
+}
+
+#endif
\ No newline at end of file
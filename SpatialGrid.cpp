@@ -0,0 +1,111 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace EpicGame {
+
+    SpatialGrid::SpatialGrid(float width, float height, float cellSize, int itemCapacity)
+        : cellSize(cellSize),
+        columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+        rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))) {
+        int cellCount = columns * rows;
+        cellStart.assign(cellCount + 1, 0);
+        cellCursor.assign(cellCount, 0);
+        cellItems.assign(itemCapacity, 0);
+        itemCells.assign(itemCapacity, -1);
+        segmentStart.assign(cellCount + 1, 0);
+    }
+
+    int SpatialGrid::cellX(float x) const {
+        return std::min(std::max(static_cast<int>(x / cellSize), 0), columns - 1);
+    }
+
+    int SpatialGrid::cellY(float y) const {
+        return std::min(std::max(static_cast<int>(y / cellSize), 0), rows - 1);
+    }
+
+    int SpatialGrid::cellIndex(float x, float y) const {
+        return cellY(y) * columns + cellX(x);
+    }
+
+    void SpatialGrid::addSegment(float x0, float y0, float x1, float y1, int kind, float margin) {
+        Segment segment = { x0, y0, x1, y1, kind };
+        segments.push_back(segment);
+
+        std::vector<int> cells;
+        float length = std::sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+        int samples = std::max(1, static_cast<int>(length / (cellSize * 0.5f))) + 1;
+        for (int i = 0; i < samples; i++) {
+            float t = samples > 1 ? static_cast<float>(i) / (samples - 1) : 0.0f;
+            float px = x0 + (x1 - x0) * t;
+            float py = y0 + (y1 - y0) * t;
+            for (int cy = cellY(py - margin); cy <= cellY(py + margin); cy++) {
+                for (int cx = cellX(px - margin); cx <= cellX(px + margin); cx++) {
+                    cells.push_back(cy * columns + cx);
+                }
+            }
+        }
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        pendingSegmentCells.push_back(cells);
+    }
+
+    void SpatialGrid::buildSegments() {
+        int cellCount = columns * rows;
+        std::fill(segmentStart.begin(), segmentStart.end(), 0);
+        for (const auto& cells : pendingSegmentCells) {
+            for (int cell : cells) {
+                segmentStart[cell + 1]++;
+            }
+        }
+        for (int cell = 0; cell < cellCount; cell++) {
+            segmentStart[cell + 1] += segmentStart[cell];
+        }
+
+        segmentItems.assign(segmentStart[cellCount], 0);
+        std::vector<int> cursor(segmentStart.begin(), segmentStart.end() - 1);
+        for (int segment = 0; segment < static_cast<int>(pendingSegmentCells.size()); segment++) {
+            for (int cell : pendingSegmentCells[segment]) {
+                segmentItems[cursor[cell]++] = segment;
+            }
+        }
+    }
+
+    void SpatialGrid::build(const float* xs, const float* ys, const uint8_t* alive, int count) {
+        int cellCount = columns * rows;
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) {
+                itemCells[i] = -1;
+                continue;
+            }
+            int cell = cellIndex(xs[i], ys[i]);
+            itemCells[i] = cell;
+            cellStart[cell + 1]++;
+        }
+        for (int cell = 0; cell < cellCount; cell++) {
+            cellStart[cell + 1] += cellStart[cell];
+            cellCursor[cell] = cellStart[cell];
+        }
+        for (int i = 0; i < count; i++) {
+            if (itemCells[i] >= 0) {
+                cellItems[cellCursor[itemCells[i]]++] = i;
+            }
+        }
+    }
+
+    bool SpatialGrid::crosses(const Segment& segment, float ax, float ay, float bx, float by) {
+        float rx = bx - ax, ry = by - ay;
+        float sx = segment.x1 - segment.x0, sy = segment.y1 - segment.y0;
+        float denominator = rx * sy - ry * sx;
+        if (denominator == 0.0f) {
+            return false;
+        }
+        float qx = segment.x0 - ax, qy = segment.y0 - ay;
+        float t = (qx * sy - qy * sx) / denominator;
+        float u = (qx * ry - qy * rx) / denominator;
+        return t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef __SPATIAL_GRID_H__
+#define __SPATIAL_GRID_H__
+
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    // Rejilla uniforme para el modo practica. Las pelotas se reparten por celda
+    // cada frame con un counting sort sobre arrays fijos; las lineas de la pista
+    // son estaticas y se registran una vez en las celdas que cruzan.
+    class SpatialGrid {
+    public:
+        struct Segment {
+            float x0, y0, x1, y1;
+            int kind;
+        };
+
+        SpatialGrid(float width, float height, float cellSize, int itemCapacity);
+
+        void addSegment(float x0, float y0, float x1, float y1, int kind, float margin);
+        void buildSegments();
+
+        void build(const float* xs, const float* ys, const uint8_t* alive, int count);
+
+        int cellIndex(float x, float y) const;
+
+        // Llama visit(item) para cada elemento en las celdas que tocan el rectangulo.
+        template <typename Visit>
+        void queryItems(float minX, float minY, float maxX, float maxY, Visit&& visit) const {
+            int cx0 = cellX(minX), cx1 = cellX(maxX);
+            int cy0 = cellY(minY), cy1 = cellY(maxY);
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    int cell = cy * columns + cx;
+                    for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                        visit(cellItems[i]);
+                    }
+                }
+            }
+        }
+
+        // Llama visit(segment) para cada linea registrada en la celda del punto.
+        template <typename Visit>
+        void querySegments(float x, float y, Visit&& visit) const {
+            int cell = cellIndex(x, y);
+            for (int i = segmentStart[cell]; i < segmentStart[cell + 1]; i++) {
+                visit(segments[segmentItems[i]]);
+            }
+        }
+
+        // Cruce del movimiento (ax, ay) -> (bx, by) con una linea.
+        static bool crosses(const Segment& segment, float ax, float ay, float bx, float by);
+
+    private:
+        int cellX(float x) const;
+        int cellY(float y) const;
+
+        float cellSize;
+        int columns;
+        int rows;
+
+        std::vector<int> cellStart;
+        std::vector<int> cellCursor;
+        std::vector<int> cellItems;
+        std::vector<int> itemCells;
+
+        std::vector<Segment> segments;
+        std::vector<std::vector<int>> pendingSegmentCells;
+        std::vector<int> segmentStart;
+        std::vector<int> segmentItems;
+    };
+
+}
+
+#endif
\ No newline at end of file
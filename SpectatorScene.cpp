@@ -0,0 +1,218 @@
+#include "SpectatorScene.h"
+#include "FramePacer.h"
+#include "MenuScene.h"
+#include <cmath>
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    namespace {
+
+        struct AtlasSource {
+            const char* file;             // nullptr: la pista, dibujada con CourtDrawing
+            float x, y, width, height;   // hueco en el atlas (origen abajo a la izquierda)
+        };
+
+        const AtlasSource ATLAS_SOURCES[] = {
+            { nullptr, 0, 0, 1024, 576 },
+            { "player1.png", 0, 576, 256, 256 },
+            { "player2.png", 256, 576, 256, 256 },
+            { "ball.png", 512, 576, 64, 64 }
+        };
+
+    }
+
+    Scene* SpectatorScene::createScene() {
+        return SpectatorScene::create();
+    }
+
+    bool SpectatorScene::init() {
+        if (!Scene::init()) {
+            return false;
+        }
+
+        if (!initAtlas()) {
+            return false;
+        }
+        initCourts();
+
+        auto keyListener = EventListenerKeyboard::create();
+        keyListener->onKeyPressed = CC_CALLBACK_2(SpectatorScene::onKeyPressed, this);
+        _eventDispatcher->addEventListenerWithSceneGraphPriority(keyListener, this);
+
+        FramePacer::getInstance()->setActivity(FramePacer::Activity::NORMAL);
+        scheduleUpdate();
+        return true;
+    }
+
+    bool SpectatorScene::initAtlas() {
+        atlas = RenderTexture::create(ATLAS_SIZE, ATLAS_SIZE);
+        if (atlas == nullptr) {
+            CCLOG("Error: No se pudo crear el atlas del modo espectador");
+            return false;
+        }
+        // El atlas no se dibuja; solo se guarda para que su textura viva con la escena.
+        atlas->setVisible(false);
+        this->addChild(atlas);
+
+        // Cada imagen se reduce a su hueco; se pinta todo de una vez y se
+        // vacia el renderer aqui para que los sprites temporales sigan vivos.
+        atlas->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+        for (int part = 0; part < ATLAS_PART_COUNT; part++) {
+            const AtlasSource& source = ATLAS_SOURCES[part];
+            atlasRects[part] = Rect(source.x, source.y, source.width, source.height);
+
+            if (part == ATLAS_COURT) {
+                auto courtNode = CourtDrawing::create(CourtGeometry::fromVisibleSize(source.width, source.height),
+                    source.height * 0.02f);
+                if (courtNode == nullptr) {
+                    CCLOG("Error: No se pudo crear la pista del atlas");
+                    atlas->end();
+                    return false;
+                }
+                courtNode->setPosition(source.x, source.y);
+                courtNode->visit();
+                atlasScales[part] = 1.0f;
+                continue;
+            }
+
+            auto sprite = Sprite::create(source.file);
+            if (sprite == nullptr) {
+                CCLOG("Error: No se pudo cargar %s", source.file);
+                atlas->end();
+                return false;
+            }
+
+            Size size = sprite->getContentSize();
+            // Jugadores y pelota mantienen la proporcion.
+            atlasScales[part] = std::min(source.width / size.width, source.height / size.height);
+            sprite->setScale(atlasScales[part]);
+            sprite->setPosition(source.x + source.width / 2, source.y + source.height / 2);
+            sprite->visit();
+        }
+        atlas->end();
+        Director::getInstance()->getRenderer()->render();
+
+        Texture2D* texture = atlas->getSprite()->getTexture();
+        texture->setAntiAliasTexParameters();
+        batch = SpriteBatchNode::createWithTexture(texture, COURT_COUNT * (4 + 2 * (MAX_GAME_PIPS + MAX_POINT_PIPS)));
+        this->addChild(batch, 1);
+        return true;
+    }
+
+    Sprite* SpectatorScene::createPart(AtlasPart part, float scale) {
+        // La textura de un RenderTexture esta invertida en vertical.
+        auto sprite = Sprite::createWithTexture(batch->getTexture(), atlasRects[part]);
+        sprite->setFlippedY(true);
+        if (part != ATLAS_COURT) {
+            sprite->setScale(scale * tileScale / atlasScales[part]);
+        }
+        batch->addChild(sprite, part == ATLAS_COURT ? 0 : 1);
+        return sprite;
+    }
+
+    void SpectatorScene::initCourts() {
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+        int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(COURT_COUNT))));
+        int rows = (COURT_COUNT + columns - 1) / columns;
+        tileSize = Size(visibleSize.width / columns, visibleSize.height / rows);
+        tileScale = std::min(tileSize.width / MatchSim::DESIGN_WIDTH, tileSize.height / MatchSim::DESIGN_HEIGHT);
+
+        courts.resize(COURT_COUNT);
+        for (int i = 0; i < COURT_COUNT; i++) {
+            Court& court = courts[i];
+            int row = i / columns;
+            int column = i % columns;
+            // Primera pista arriba a la izquierda.
+            court.origin = Vec2(column * tileSize.width, visibleSize.height - (row + 1) * tileSize.height);
+
+            auto courtSprite = createPart(ATLAS_COURT, 1.0f);
+            courtSprite->setScale(tileSize.width / atlasRects[ATLAS_COURT].size.width,
+                tileSize.height / atlasRects[ATLAS_COURT].size.height);
+            courtSprite->setPosition(court.origin + Vec2(tileSize.width / 2, tileSize.height / 2));
+
+            court.player1 = createPart(ATLAS_PLAYER1, FRONT_PLAYER_SCALE);
+            court.player2 = createPart(ATLAS_PLAYER2, BACK_PLAYER_SCALE);
+            court.ball = createPart(ATLAS_BALL, BALL_BASE_SCALE);
+
+            // Fichas del marcador: juegos y puntos de cada jugador, player1
+            // en el borde de abajo y player2 en el de arriba.
+            float pipStep = tileSize.width * 0.03f;
+            for (int player = 0; player < 2; player++) {
+                float y = player == 0 ? tileSize.height * 0.05f : tileSize.height * 0.95f;
+                for (int pip = 0; pip < MAX_GAME_PIPS; pip++) {
+                    auto sprite = createPart(ATLAS_BALL, PIP_SCALE);
+                    sprite->setColor(Color3B::YELLOW);
+                    sprite->setPosition(court.origin + Vec2(pipStep * (pip + 1), y));
+                    court.gamePips[player][pip] = sprite;
+                }
+                for (int pip = 0; pip < MAX_POINT_PIPS; pip++) {
+                    auto sprite = createPart(ATLAS_BALL, PIP_SCALE);
+                    sprite->setPosition(court.origin + Vec2(tileSize.width - pipStep * (pip + 1), y));
+                    court.pointPips[player][pip] = sprite;
+                }
+            }
+
+            court.sim.reset(new MatchSim());
+            court.seed = nextSeed++;
+            court.sim->reset(court.seed);
+            updateCourt(court);
+        }
+    }
+
+    void SpectatorScene::update(float delta) {
+        // Paso fijo como en las herramientas; si un frame tarda mucho se
+        // recorta en vez de acumular pasos.
+        stepAccumulator = std::min(stepAccumulator + delta, FIXED_STEP * MAX_STEPS_PER_FRAME);
+        while (stepAccumulator >= FIXED_STEP) {
+            stepAccumulator -= FIXED_STEP;
+            for (Court& court : courts) {
+                MatchStepper<ScriptedAIPolicy, ScriptedAIPolicy>(*court.sim).step(FIXED_STEP);
+
+                // Al terminar un set la pista empieza otro partido.
+                const MatchScore& score = court.sim->getState().score;
+                if (score.player1Sets + score.player2Sets > 0) {
+                    court.seed = nextSeed++;
+                    court.sim->reset(court.seed);
+                }
+            }
+        }
+
+        for (Court& court : courts) {
+            updateCourt(court);
+        }
+    }
+
+    void SpectatorScene::updateCourt(Court& court) {
+        const MatchSim::State& state = court.sim->getState();
+        auto toTile = [&](Scalar x, Scalar y) {
+            return court.origin + Vec2(toFloat(x) / MatchSim::DESIGN_WIDTH * tileSize.width,
+                toFloat(y) / MatchSim::DESIGN_HEIGHT * tileSize.height);
+        };
+
+        court.player1->setPosition(toTile(state.player1X, state.player1Y));
+        court.player2->setPosition(toTile(state.player2X, state.player2Y));
+        court.ball->setPosition(toTile(state.ball.x, state.ball.y));
+        court.ball->setVisible(state.ballInPlay || state.gameState == MatchSim::GameState::SERVE);
+
+        const MatchScore& score = state.score;
+        int games[2] = { score.player1Games, score.player2Games };
+        int points[2] = { score.player1Points, score.player2Points };
+        for (int player = 0; player < 2; player++) {
+            for (int pip = 0; pip < MAX_GAME_PIPS; pip++) {
+                court.gamePips[player][pip]->setVisible(pip < games[player]);
+            }
+            for (int pip = 0; pip < MAX_POINT_PIPS; pip++) {
+                court.pointPips[player][pip]->setVisible(pip < points[player]);
+            }
+        }
+    }
+
+    void SpectatorScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event) {
+        if (keyCode == EventKeyboard::KeyCode::KEY_ESCAPE) {
+            Director::getInstance()->replaceScene(TransitionFade::create(0.5f, MenuScene::createScene()));
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef __SPECTATOR_SCENE_H__
+#define __SPECTATOR_SCENE_H__
+
+#include "cocos2d.h"
+#include "CourtDrawing.h"
+#include "MatchSim.h"
+#include "MatchStepper.h"
+#include <memory>
+#include <vector>
+
+namespace EpicGame {
+
+    // Modo espectador: COURT_COUNT partidos IA contra IA a la vez, cada uno en
+    // su celda de una rejilla. Pista, jugadores, pelota y marcador salen de un
+    // atlas que se monta al entrar (una sola textura) y cuelgan de un unico
+    // SpriteBatchNode, asi que todas las pistas se pintan en una llamada. El
+    // marcador son fichas (juegos y puntos), no etiquetas de texto.
+    class SpectatorScene : public cocos2d::Scene {
+    public:
+        static cocos2d::Scene* createScene();
+        virtual bool init();
+        CREATE_FUNC(SpectatorScene);
+
+    private:
+        static const int COURT_COUNT = 16;
+        static const int MAX_GAME_PIPS = 6;
+        static const int MAX_POINT_PIPS = 4;
+        static const int ATLAS_SIZE = 1024;
+        static const int MAX_STEPS_PER_FRAME = 4;
+        static constexpr float FIXED_STEP = 1.0f / 60.0f;
+
+        const float FRONT_PLAYER_SCALE = 0.4f;
+        const float BACK_PLAYER_SCALE = 0.18f;
+        const float BALL_BASE_SCALE = 0.05f;
+        const float PIP_SCALE = 0.035f;
+
+        enum AtlasPart {
+            ATLAS_COURT,
+            ATLAS_PLAYER1,
+            ATLAS_PLAYER2,
+            ATLAS_BALL,
+            ATLAS_PART_COUNT
+        };
+
+        struct Court {
+            std::unique_ptr<MatchSim> sim;
+            cocos2d::Vec2 origin;
+            cocos2d::Sprite* player1 = nullptr;
+            cocos2d::Sprite* player2 = nullptr;
+            cocos2d::Sprite* ball = nullptr;
+            cocos2d::Sprite* gamePips[2][MAX_GAME_PIPS] = {};
+            cocos2d::Sprite* pointPips[2][MAX_POINT_PIPS] = {};
+            uint64_t seed = 0;
+        };
+
+        cocos2d::RenderTexture* atlas = nullptr;
+        cocos2d::Rect atlasRects[ATLAS_PART_COUNT];
+        float atlasScales[ATLAS_PART_COUNT] = {};   // tamano en el atlas / tamano original
+        cocos2d::SpriteBatchNode* batch = nullptr;
+        std::vector<Court> courts;
+        cocos2d::Size tileSize;
+        float tileScale = 1.0f;
+        float stepAccumulator = 0.0f;
+        uint64_t nextSeed = 1;
+
+        bool initAtlas();
+        void initCourts();
+        cocos2d::Sprite* createPart(AtlasPart part, float scale);
+
+        void update(float delta) override;
+        void updateCourt(Court& court);
+
+        void onKeyPressed(cocos2d::EventKeyboard::KeyCode keyCode, cocos2d::Event* event);
+    };
+
+}
+
+#endif
\ No newline at end of file
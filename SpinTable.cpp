@@ -0,0 +1,308 @@
+#include "SpinTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace EpicGame {
+
+    // Por tipo de golpe, en el orden de ShotType sin NORMAL. Angulos y alturas
+    // elegidos para que la velocidad nominal de cada golpe bote dentro desde
+    // el fondo de la pista. Senos y cosenos redondeados a float a mano.
+    static const SpinTable::Family FAMILIES[SpinTable::FAMILY_COUNT] = {
+        // TOPSPIN: sale a 7 grados
+        { 15.0f, 40.0f, 1.0f / 25.0f, 0.992546141f, 0.121869341f, 1.0f, 1.0f, 1.0f, 0.0f },
+        // SLICE: 6 grados, eje inclinado 0.3 rad; flota y se abre
+        { 12.0f, 32.0f, 1.0f / 20.0f, 0.994521916f, 0.104528464f, 1.0f, -1.0f, -0.955336511f, 0.295520216f },
+        // LOB: 24 grados
+        { 10.0f, 28.0f, 1.0f / 18.0f, 0.91354543f, 0.406736642f, 0.8f, 1.0f, 1.0f, 0.0f },
+        // SMASH: 4 grados hacia abajo
+        { 20.0f, 45.0f, 1.0f / 25.0f, 0.997564077f, -0.0697564706f, 2.6f, 1.0f, 1.0f, 0.0f }
+    };
+
+    struct Corner {
+        int index;
+        float weight;
+    };
+
+    static float binValue(int bin, float minValue, float maxValue, int bins) {
+        return minValue + (maxValue - minValue) * bin / (bins - 1);
+    }
+
+    // Bin inferior y fraccion hasta el siguiente, con value recortado al rango.
+    // Se llama en cada paso: multiplica por el inverso del rango en vez de dividir.
+    static int binBelow(float value, float minValue, float inverseRange, int bins, float& fraction) {
+        float position = (value - minValue) * inverseRange;
+        position = std::min(std::max(position, 0.0f), 1.0f) * (bins - 1);
+        int bin = std::min(static_cast<int>(position), bins - 2);
+        fraction = position - bin;
+        return bin;
+    }
+
+    template <typename T>
+    static void pixelsPerMetre(const CourtGeometryT<T>& court, float& scaleX, float& scaleY) {
+        scaleX = toFloat(court.courtWidth) * (1.0f / SpinTable::COURT_WIDTH);
+        scaleY = toFloat(court.height - court.baselineOffset * T(2)) * (1.0f / SpinTable::COURT_LENGTH);
+    }
+
+    SpinTable* SpinTable::getInstance() {
+        static SpinTable instance;
+        return &instance;
+    }
+
+    const SpinTable::Family& SpinTable::getFamily(ShotType shot) {
+        int family = std::min(std::max(static_cast<int>(shot) - 1, 0), FAMILY_COUNT - 1);
+        return FAMILIES[family];
+    }
+
+    int SpinTable::trajectoryIndex(int family, int speedBin, int spinBin) {
+        return (family * SPEED_BINS + speedBin) * SPIN_BINS + spinBin;
+    }
+
+    SpinTable::SpinTable() {
+        int trajectories = FAMILY_COUNT * SPEED_BINS * SPIN_BINS;
+        samples.resize(static_cast<size_t>(trajectories) * MAX_SAMPLES);
+        sampleCounts.resize(trajectories);
+        landings.resize(trajectories);
+
+        for (int family = 0; family < FAMILY_COUNT; family++) {
+            for (int speedBin = 0; speedBin < SPEED_BINS; speedBin++) {
+                for (int spinBin = 0; spinBin < SPIN_BINS; spinBin++) {
+                    build(family, speedBin, spinBin);
+                }
+            }
+        }
+    }
+
+    void SpinTable::build(int family, int speedBin, int spinBin) {
+        const Family& shot = FAMILIES[family];
+        float speed = binValue(speedBin, shot.minSpeed, shot.maxSpeed, SPEED_BINS);
+        float spin = binValue(spinBin, 0.0f, MAX_SPIN, SPIN_BINS);
+
+        // Eje de giro en (avance, lateral, altura); la componente de avance es 0.
+        float axisSide = shot.axisSide;
+        float axisUp = shot.axisUp;
+
+        float forward = 0.0f;
+        float side = 0.0f;
+        float height = shot.contactHeight;
+        float vForward = speed * shot.launchForward;
+        float vSide = 0.0f;
+        float vUp = speed * shot.launchUp;
+        const float dt = SAMPLE_TIME / SUBSTEPS;
+
+        int index = trajectoryIndex(family, speedBin, spinBin);
+        Point* out = &samples[static_cast<size_t>(index) * MAX_SAMPLES];
+        Landing& landing = landings[index];
+        out[0].forward = forward;
+        out[0].side = side;
+        out[0].height = height;
+
+        int count = 1;
+        bool landed = false;
+        while (count < MAX_SAMPLES && !landed) {
+            for (int substep = 0; substep < SUBSTEPS && !landed; substep++) {
+                float v = std::sqrt(vForward * vForward + vSide * vSide + vUp * vUp);
+                // Magnus: LIFT * spin * |v| * (eje x v).
+                float lift = LIFT * spin * v;
+                vForward += (-DRAG * v * vForward + lift * (axisSide * vUp - axisUp * vSide)) * dt;
+                vSide += (-DRAG * v * vSide + lift * axisUp * vForward) * dt;
+                vUp += (-GRAVITY - DRAG * v * vUp - lift * axisSide * vForward) * dt;
+
+                float nextForward = forward + vForward * dt;
+                float nextSide = side + vSide * dt;
+                float nextHeight = height + vUp * dt;
+                if (nextHeight <= 0.0f) {
+                    float fraction = height / (height - nextHeight);
+                    landing.time = (count - 1) * SAMPLE_TIME + (substep + fraction) * dt;
+                    landing.point.forward = forward + (nextForward - forward) * fraction;
+                    landing.point.side = side + (nextSide - side) * fraction;
+                    landing.point.height = 0.0f;
+                    landed = true;
+                }
+                forward = nextForward;
+                side = nextSide;
+                height = nextHeight;
+            }
+
+            if (landed) {
+                out[count] = landing.point;
+            }
+            else {
+                out[count].forward = forward;
+                out[count].side = side;
+                out[count].height = height;
+            }
+            count++;
+        }
+
+        if (!landed) {
+            landing.time = (count - 1) * SAMPLE_TIME;
+            landing.point = out[count - 1];
+        }
+        landing.forwardSpeed = vForward * (BOUNCE_FRICTION + shot.spinSign * spin * SPIN_KICK);
+        landing.sideSpeed = vSide * BOUNCE_FRICTION;
+        sampleCounts[index] = count;
+    }
+
+    static void cornersFor(ShotType shot, float speed, float spin, Corner corners[4]) {
+        const SpinTable::Family& family = SpinTable::getFamily(shot);
+        int familyIndex = std::min(std::max(static_cast<int>(shot) - 1, 0), SpinTable::FAMILY_COUNT - 1);
+        float speedFraction;
+        float spinFraction;
+        int speedBin = binBelow(speed, family.minSpeed, family.inverseSpeedRange, SpinTable::SPEED_BINS, speedFraction);
+        int spinBin = binBelow(spin, 0.0f, 1.0f / SpinTable::MAX_SPIN, SpinTable::SPIN_BINS, spinFraction);
+
+        for (int corner = 0; corner < 4; corner++) {
+            int speedStep = corner & 1;
+            int spinStep = corner >> 1;
+            corners[corner].index = (familyIndex * SpinTable::SPEED_BINS + speedBin + speedStep) *
+                SpinTable::SPIN_BINS + spinBin + spinStep;
+            corners[corner].weight = (speedStep ? speedFraction : 1.0f - speedFraction) *
+                (spinStep ? spinFraction : 1.0f - spinFraction);
+        }
+    }
+
+    SpinTable::Landing SpinTable::getLanding(ShotType shot, float speed, float spin) const {
+        Corner corners[4];
+        cornersFor(shot, speed, spin, corners);
+
+        Landing result;
+        for (const Corner& corner : corners) {
+            const Landing& landing = landings[corner.index];
+            result.time += landing.time * corner.weight;
+            result.point.forward += landing.point.forward * corner.weight;
+            result.point.side += landing.point.side * corner.weight;
+            result.forwardSpeed += landing.forwardSpeed * corner.weight;
+            result.sideSpeed += landing.sideSpeed * corner.weight;
+        }
+        return result;
+    }
+
+    bool SpinTable::evaluate(ShotType shot, float speed, float spin, float time, Point& point) const {
+        Corner corners[4];
+        cornersFor(shot, speed, spin, corners);
+
+        float landingTime = 0.0f;
+        for (const Corner& corner : corners) {
+            landingTime += landings[corner.index].time * corner.weight;
+        }
+        if (time >= landingTime) {
+            point = getLanding(shot, speed, spin).point;
+            return false;
+        }
+
+        float position = std::max(time, 0.0f) * (1.0f / SAMPLE_TIME);
+        int sample = static_cast<int>(position);
+        float fraction = position - sample;
+
+        point = Point();
+        for (const Corner& corner : corners) {
+            // Las trayectorias vecinas pueden haber botado antes: se quedan en su bote.
+            int last = sampleCounts[corner.index] - 1;
+            const Point* trajectory = &samples[static_cast<size_t>(corner.index) * MAX_SAMPLES];
+            const Point& a = trajectory[std::min(sample, last)];
+            const Point& b = trajectory[std::min(sample + 1, last)];
+            point.forward += (a.forward + (b.forward - a.forward) * fraction) * corner.weight;
+            point.side += (a.side + (b.side - a.side) * fraction) * corner.weight;
+            point.height += (a.height + (b.height - a.height) * fraction) * corner.weight;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void SpinTable::launch(SpinFlightT<T>& flight, const BallStateT<T>& ball, ShotType shot, T spin,
+        const CourtGeometryT<T>& court) {
+        flight = SpinFlightT<T>();
+
+        float scaleX;
+        float scaleY;
+        pixelsPerMetre(court, scaleX, scaleY);
+        float vx = toFloat(ball.vx) / scaleX;
+        float vy = toFloat(ball.vy) / scaleY;
+        float speed = std::sqrt(vx * vx + vy * vy);
+        if (shot == ShotType::NORMAL || speed <= 0.0f) {
+            return;
+        }
+
+        flight.shot = shot;
+        flight.originX = ball.x;
+        flight.originY = ball.y;
+        flight.dirX = T(vx / speed);
+        flight.dirY = T(vy / speed);
+        flight.speed = T(speed);
+        flight.spin = spin;
+        flight.height = T(getFamily(shot).contactHeight);
+    }
+
+    template <typename T>
+    FlightResult SpinTable::step(BallStateT<T>& ball, SpinFlightT<T>& flight, T delta,
+        const CourtGeometryT<T>& court, bool& player1Won) {
+        float scaleX;
+        float scaleY;
+        pixelsPerMetre(court, scaleX, scaleY);
+        float dirX = toFloat(flight.dirX);
+        float dirY = toFloat(flight.dirY);
+        // Todo lo que acaba el punto durante el vuelo es error de quien golpeo.
+        player1Won = dirY < 0.0f;
+
+        flight.time += delta;
+        Point point;
+        bool flying = getInstance()->evaluate(flight.shot, toFloat(flight.speed), toFloat(flight.spin),
+            toFloat(flight.time), point);
+
+        T newX = flight.originX + T((dirX * point.forward + dirY * point.side) * scaleX);
+        T newY = flight.originY + T((dirY * point.forward - dirX * point.side) * scaleY);
+
+        T netY = court.height * T(0.5f);
+        if ((ball.y < netY) != (newY < netY)) {
+            float fraction = toFloat(netY - ball.y) / toFloat(newY - ball.y);
+            float previousHeight = toFloat(flight.height);
+            if (previousHeight + (point.height - previousHeight) * fraction < NET_HEIGHT) {
+                return FlightResult::NET;
+            }
+        }
+
+        if (newY < court.height * T(0.05f) || newY > court.height * T(0.95f)) {
+            return FlightResult::OUT_LONG;
+        }
+        if (newX < court.width * T(0.1f) || newX > court.width * T(0.9f)) {
+            return FlightResult::OUT_WIDE;
+        }
+
+        if (delta > T(0.0f)) {
+            ball.vx = (newX - ball.x) / delta;
+            ball.vy = (newY - ball.y) / delta;
+        }
+        ball.x = newX;
+        ball.y = newY;
+        flight.height = T(point.height);
+        if (flying) {
+            return FlightResult::IN_PLAY;
+        }
+
+        // Bote: a partir de aqui la pelota sigue con BallFlight::step.
+        Landing landing = getInstance()->getLanding(flight.shot, toFloat(flight.speed), toFloat(flight.spin));
+        ball.vx = T((dirX * landing.forwardSpeed + dirY * landing.sideSpeed) * scaleX);
+        ball.vy = T((dirY * landing.forwardSpeed - dirX * landing.sideSpeed) * scaleY);
+        bool ownSide = (ball.y < netY) == (flight.originY < netY);
+        flight = SpinFlightT<T>();
+
+        if (ownSide) {
+            return FlightResult::NET;
+        }
+        if (BallFlight::isOutOfCourt(ball, court)) {
+            bool beyondBaseline = ball.y < court.baselineOffset || ball.y > court.height - court.baselineOffset;
+            return beyondBaseline ? FlightResult::OUT_LONG : FlightResult::OUT_WIDE;
+        }
+        return FlightResult::IN_PLAY;
+    }
+
+    template void SpinTable::launch<float>(SpinFlightT<float>&, const BallStateT<float>&, ShotType, float,
+        const CourtGeometryT<float>&);
+    template void SpinTable::launch<Fixed>(SpinFlightT<Fixed>&, const BallStateT<Fixed>&, ShotType, Fixed,
+        const CourtGeometryT<Fixed>&);
+    template FlightResult SpinTable::step<float>(BallStateT<float>&, SpinFlightT<float>&, float,
+        const CourtGeometryT<float>&, bool&);
+    template FlightResult SpinTable::step<Fixed>(BallStateT<Fixed>&, SpinFlightT<Fixed>&, Fixed,
+        const CourtGeometryT<Fixed>&, bool&);
+
+}
\ No newline at end of file
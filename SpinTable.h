@@ -0,0 +1,128 @@
+#ifndef __SPIN_TABLE_H__
+#define __SPIN_TABLE_H__
+
+#include "BallFlight.h"
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    enum class ShotType : uint8_t {
+        NORMAL,
+        TOPSPIN,
+        SLICE,
+        LOB,
+        SMASH
+    };
+
+    // Golpe con efecto en vuelo. Hasta que bota la pelota sigue la tabla;
+    // despues shot vuelve a NORMAL y sigue con BallFlight::step.
+    template <typename T>
+    struct SpinFlightT {
+        ShotType shot = ShotType::NORMAL;
+        T time = 0.0f;          // s desde el golpe
+        T originX = 0.0f;       // punto de golpeo, en pixeles
+        T originY = 0.0f;
+        T dirX = 0.0f;          // direccion unitaria en metros de pista
+        T dirY = 0.0f;
+        T speed = 0.0f;         // m/s de salida
+        T spin = 0.0f;          // coeficiente de sustentacion, de 0 a MAX_SPIN
+        T height = 0.0f;        // m sobre la pista, para dibujar y para la red
+    };
+
+    typedef SpinFlightT<float> SpinFlight;
+
+    // Trayectorias de liftado, cortado, globo y remate, calculadas una vez al
+    // arrancar con gravedad, rozamiento cuadratico y fuerza de Magnus en una
+    // pista de metros (avance, lateral, altura). Para cada tipo hay una
+    // familia de SPEED_BINS x SPIN_BINS trayectorias muestreadas cada
+    // SAMPLE_TIME hasta el primer bote. En juego solo se interpola: ni
+    // TennisScene ni MatchSim integran fuerzas por paso.
+    //
+    // La tabla se calcula en float con sumas, productos, divisiones y sqrt,
+    // asi que sale igual en cualquier maquina con IEEE 754 si no se fusionan
+    // operaciones (-ffp-contract=off en las compilaciones TENNIS_FIXED_POINT).
+    // Por eso Family guarda senos y cosenos ya calculados y no angulos: sin y
+    // cos de cada libm pueden diferir en el ultimo bit.
+    class SpinTable {
+    public:
+        static constexpr float COURT_LENGTH = 23.77f;   // m
+        static constexpr float COURT_WIDTH = 10.97f;
+        static constexpr float NET_HEIGHT = 0.914f;
+        static constexpr float GRAVITY = 9.81f;
+        static constexpr float DRAG = 0.0195f;          // 0.5 * rho * Cd * A / m, en 1/m
+        static constexpr float LIFT = 0.0355f;          // 0.5 * rho * A / m; por el coeficiente
+        static constexpr float BOUNCE_FRICTION = 0.6f;  // velocidad horizontal que queda al botar
+        static constexpr float SPIN_KICK = 1.0f;        // el liftado acelera el bote, el cortado lo frena
+        static constexpr float MAX_SPIN = 0.4f;
+        static constexpr float REACH_HEIGHT = 3.0f;     // m; mas alta no se puede golpear
+
+        static const int FAMILY_COUNT = 4;              // todos menos NORMAL
+        static const int SPEED_BINS = 16;
+        static const int SPIN_BINS = 5;
+        static const int MAX_SAMPLES = 256;
+        static const int SUBSTEPS = 16;
+        static constexpr float SAMPLE_TIME = 1.0f / 60.0f;
+
+        struct Family {
+            float minSpeed;         // m/s
+            float maxSpeed;
+            float inverseSpeedRange; // 1 / (maxSpeed - minSpeed)
+            float launchForward;    // cos del angulo de salida sobre la horizontal
+            float launchUp;         // sin del angulo de salida
+            float contactHeight;    // m
+            float spinSign;         // 1 liftado, -1 cortado
+            float axisSide;         // eje de giro: spinSign * cos(inclinacion hacia la vertical)
+            float axisUp;           // sin(inclinacion); con inclinacion la pelota se abre
+        };
+
+        struct Point {
+            float forward = 0.0f;   // m en la direccion del golpe
+            float side = 0.0f;      // m a la derecha de esa direccion
+            float height = 0.0f;
+        };
+
+        struct Landing {
+            float time = 0.0f;
+            Point point;
+            float forwardSpeed = 0.0f;  // m/s justo despues del bote
+            float sideSpeed = 0.0f;
+        };
+
+        static SpinTable* getInstance();
+        static const Family& getFamily(ShotType shot);
+
+        // Posicion a time s del golpe. Devuelve false si la pelota ya ha
+        // botado; entonces point es el punto del bote.
+        bool evaluate(ShotType shot, float speed, float spin, float time, Point& point) const;
+        Landing getLanding(ShotType shot, float speed, float spin) const;
+
+        // Empieza un golpe desde la posicion y velocidad (pixeles) de ball.
+        // Con NORMAL solo limpia flight.
+        template <typename T>
+        static void launch(SpinFlightT<T>& flight, const BallStateT<T>& ball, ShotType shot, T spin,
+            const CourtGeometryT<T>& court);
+
+        // Equivalente a BallFlight::step mientras flight.shot != NORMAL. Si la
+        // pelota no pasa la red, sale de la pantalla o bota fuera pierde quien
+        // golpeo; si bota dentro sigue en juego con la velocidad del bote.
+        template <typename T>
+        static FlightResult step(BallStateT<T>& ball, SpinFlightT<T>& flight, T delta,
+            const CourtGeometryT<T>& court, bool& player1Won);
+
+    private:
+        SpinTable();
+        SpinTable(const SpinTable&) = delete;
+        SpinTable& operator=(const SpinTable&) = delete;
+
+        void build(int family, int speedBin, int spinBin);
+        static int trajectoryIndex(int family, int speedBin, int spinBin);
+
+        std::vector<Point> samples;         // MAX_SAMPLES por trayectoria
+        std::vector<int> sampleCounts;
+        std::vector<Landing> landings;
+    };
+
+}
+
+#endif
\ No newline at end of file
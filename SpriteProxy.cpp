@@ -0,0 +1,100 @@
+#include "SpriteProxy.h"
+
+USING_NS_CC;
+
+namespace EpicGame {
+
+    int SpriteProxy::add(Sprite* sprite) {
+        State state;
+        state.position = sprite->getPosition();
+        state.scale = sprite->getScale();
+        state.opacity = sprite->getOpacity();
+        state.visible = sprite->isVisible();
+        state.zOrder = sprite->getLocalZOrder();
+
+        sprites.push_back(sprite);
+        desired.push_back(state);
+        applied.push_back(state);
+        dirty.push_back(0);
+        return size() - 1;
+    }
+
+    void SpriteProxy::clear() {
+        sprites.clear();
+        desired.clear();
+        applied.clear();
+        dirty.clear();
+        dirtyList.clear();
+    }
+
+    void SpriteProxy::markDirty(int index) {
+        if (!dirty[index]) {
+            dirty[index] = 1;
+            dirtyList.push_back(index);
+        }
+    }
+
+    void SpriteProxy::setPosition(int index, const Vec2& position) {
+        if (desired[index].position != position) {
+            desired[index].position = position;
+            markDirty(index);
+        }
+    }
+
+    void SpriteProxy::setScale(int index, float scale) {
+        if (desired[index].scale != scale) {
+            desired[index].scale = scale;
+            markDirty(index);
+        }
+    }
+
+    void SpriteProxy::setOpacity(int index, uint8_t opacity) {
+        if (desired[index].opacity != opacity) {
+            desired[index].opacity = opacity;
+            markDirty(index);
+        }
+    }
+
+    void SpriteProxy::setVisible(int index, bool visible) {
+        if (desired[index].visible != visible) {
+            desired[index].visible = visible;
+            markDirty(index);
+        }
+    }
+
+    void SpriteProxy::setLocalZOrder(int index, int zOrder) {
+        if (desired[index].zOrder != zOrder) {
+            desired[index].zOrder = zOrder;
+            markDirty(index);
+        }
+    }
+
+    void SpriteProxy::flush() {
+        for (int index : dirtyList) {
+            dirty[index] = 0;
+            const State& want = desired[index];
+            State& have = applied[index];
+            Sprite* sprite = sprites[index];
+
+            // Un valor que cambio y volvio dentro del mismo frame no se escribe.
+            if (want.position != have.position) {
+                sprite->setPosition(want.position);
+            }
+            if (want.scale != have.scale) {
+                sprite->setScale(want.scale);
+            }
+            if (want.opacity != have.opacity) {
+                sprite->setOpacity(want.opacity);
+            }
+            if (want.visible != have.visible) {
+                sprite->setVisible(want.visible);
+            }
+            if (want.zOrder != have.zOrder) {
+                sprite->setLocalZOrder(want.zOrder);
+            }
+            have = want;
+        }
+        dirtyList.clear();
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef __SPRITE_PROXY_H__
+#define __SPRITE_PROXY_H__
+
+#include "cocos2d.h"
+#include <cstdint>
+#include <vector>
+
+namespace EpicGame {
+
+    // Estado que los sistemas quieren para cada sprite durante el frame. Los
+    // setters solo guardan el valor; flush() lo compara con lo ultimo que se
+    // escribio al Node y llama a setPosition/setScale/setOpacity/setVisible/
+    // setLocalZOrder solo para lo que ha cambiado. Asi un sprite quieto no
+    // marca su transformada como sucia ni obliga a reordenar los hijos.
+    class SpriteProxy {
+    public:
+        // Lee el estado actual del sprite, que ya tiene que estar en la escena.
+        int add(cocos2d::Sprite* sprite);
+        void clear();
+
+        int size() const { return static_cast<int>(sprites.size()); }
+        cocos2d::Sprite* getSprite(int index) const { return sprites[index]; }
+
+        void setPosition(int index, const cocos2d::Vec2& position);
+        void setScale(int index, float scale);
+        void setOpacity(int index, uint8_t opacity);
+        void setVisible(int index, bool visible);
+        void setLocalZOrder(int index, int zOrder);
+        bool isVisible(int index) const { return desired[index].visible; }
+
+        // Una vez por frame, antes de dibujar.
+        void flush();
+
+    private:
+        struct State {
+            cocos2d::Vec2 position;
+            float scale = 1.0f;
+            uint8_t opacity = 255;
+            bool visible = true;
+            int zOrder = 0;
+        };
+
+        void markDirty(int index);
+
+        std::vector<cocos2d::Sprite*> sprites;
+        std::vector<State> desired;
+        std::vector<State> applied;
+        std::vector<uint8_t> dirty;
+        std::vector<int> dirtyList;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef __STATE_HASH_H__
+#define __STATE_HASH_H__
+
+#include "FixedPoint.h"
+#include <cstdint>
+#include <cstring>
+
+namespace EpicGame {
+
+    // Hash incremental estilo xxHash64: cada campo entra como una ronda de
+    // 8 bytes y finish() aplica la mezcla final. Unos pocos ciclos por campo,
+    // asi que se puede dejar activo en cada frame.
+    class StateHasher {
+    public:
+        explicit StateHasher(uint64_t seed = 0)
+            : accumulator(seed + PRIME5) {
+        }
+
+        void add(uint64_t value) {
+            accumulator ^= round(value);
+            accumulator = rotl(accumulator, 27) * PRIME1 + PRIME4;
+            length += 8;
+        }
+
+        // Los float entran por sus bits: 0.0f y -0.0f dan hash distinto a proposito.
+        void add(float value) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            add(static_cast<uint64_t>(bits));
+        }
+
+        void add(Fixed value) { add(static_cast<uint64_t>(static_cast<uint32_t>(value.raw))); }
+        void add(int value) { add(static_cast<uint64_t>(static_cast<uint32_t>(value))); }
+        void add(bool value) { add(static_cast<uint64_t>(value ? 1 : 0)); }
+
+        uint64_t finish() const {
+            uint64_t hash = accumulator + length;
+            hash ^= hash >> 33;
+            hash *= PRIME2;
+            hash ^= hash >> 29;
+            hash *= PRIME3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+    private:
+        static constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+        static constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+        static constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+        static constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+        static uint64_t rotl(uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        static uint64_t round(uint64_t input) {
+            return rotl(input * PRIME2, 31) * PRIME1;
+        }
+
+        uint64_t accumulator;
+        uint64_t length = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
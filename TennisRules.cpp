@@ -0,0 +1,136 @@
+#include "TennisRules.h"
+#include <algorithm>
+
+namespace EpicGame {
+
+    static const char* const TENNIS_POINTS[] = { "0", "15", "30", "40", "Ad" };
+
+    bool MatchScore::awardPoint(bool player1Won) {
+        if (player1Won) {
+            player1Points++;
+        }
+        else {
+            player2Points++;
+        }
+
+        bool gameWon = false;
+
+        if (player1Points >= 3 && player2Points >= 3) {
+            // Solo en iguales: con ventaja getPointText tiene que poner Ad.
+            isDeuce = player1Points == player2Points;
+            if (player1Points - player2Points >= 2) {
+                player1Games++;
+                gameWon = true;
+            }
+            else if (player2Points - player1Points >= 2) {
+                player2Games++;
+                gameWon = true;
+            }
+        }
+        else {
+            if (player1Points >= 4 && player1Points - player2Points >= 2) {
+                player1Games++;
+                gameWon = true;
+            }
+            else if (player2Points >= 4 && player2Points - player1Points >= 2) {
+                player2Games++;
+                gameWon = true;
+            }
+        }
+
+        if (gameWon) {
+            if (player1Games >= 6 && player1Games - player2Games >= 2) {
+                player1Sets++;
+                player1Games = player2Games = 0;
+            }
+            else if (player2Games >= 6 && player2Games - player1Games >= 2) {
+                player2Sets++;
+                player1Games = player2Games = 0;
+            }
+
+            player1Points = player2Points = 0;
+            isDeuce = false;
+            faultCount = 0;
+        }
+
+        return gameWon;
+    }
+
+    void MatchScore::switchServer() {
+        servingPlayer = (servingPlayer == 1) ? 2 : 1;
+        if (servingPlayer == 2) {
+            isDeuceSide = false;
+        }
+        else {
+            isDeuceSide = true;
+        }
+
+        faultCount = 0;
+    }
+
+    void MatchScore::alternateServiceSide() {
+        isDeuceSide = !isDeuceSide;
+    }
+
+    bool MatchScore::isInServiceBox(float x, float y, float width, float height) const {
+        float centerX = width * 0.5f;
+        float serviceBoxWidth = width * SERVICE_BOX_HALF_WIDTH;
+
+        if (servingPlayer == 1) {
+            float minY = height * (1.0f - SERVICE_BOX_FRONT);
+            float maxY = height * (1.0f - SERVICE_BOX_BACK);
+
+            if (isDeuceSide) {
+                return x >= centerX - serviceBoxWidth && x <= centerX && y >= minY && y <= maxY;
+            }
+            else {
+                return x >= centerX && x <= centerX + serviceBoxWidth && y >= minY && y <= maxY;
+            }
+        }
+        else {
+            float minY = height * SERVICE_BOX_BACK;
+            float maxY = height * SERVICE_BOX_FRONT;
+
+            // Tambien en diagonal: desde la derecha de la pantalla a la caja izquierda.
+            if (isDeuceSide) {
+                return x >= centerX - serviceBoxWidth && x <= centerX && y >= minY && y <= maxY;
+            }
+            else {
+                return x >= centerX && x <= centerX + serviceBoxWidth && y >= minY && y <= maxY;
+            }
+        }
+    }
+
+    std::string MatchScore::getPointText() const {
+        std::string p1Score, p2Score;
+
+        if (isDeuce) {
+            p1Score = p2Score = "40";
+        }
+        else if (player1Points >= 3 && player2Points >= 3) {
+            if (player1Points > player2Points) {
+                p1Score = "Ad";
+                p2Score = "40";
+            }
+            else if (player2Points > player1Points) {
+                p1Score = "40";
+                p2Score = "Ad";
+            }
+            else {
+                p1Score = p2Score = "40";
+            }
+        }
+        else {
+            p1Score = TENNIS_POINTS[std::min(player1Points, 4)];
+            p2Score = TENNIS_POINTS[std::min(player2Points, 4)];
+        }
+
+        return p1Score + " - " + p2Score;
+    }
+
+    std::string MatchScore::getGameText() const {
+        return std::to_string(player1Games) + "-" + std::to_string(player2Games) +
+            " (" + std::to_string(player1Sets) + "-" + std::to_string(player2Sets) + ")";
+    }
+
+}
\ No newline at end of file
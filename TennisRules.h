@@ -0,0 +1,46 @@
+#ifndef __TENNIS_RULES_H__
+#define __TENNIS_RULES_H__
+
+#include <string>
+
+namespace EpicGame {
+
+    // Marcador y reglas de saque sin dependencias de cocos2d. Lo usan tanto
+    // TennisScene como la simulacion sin ventana (MatchSim).
+    struct MatchScore {
+        int player1Points = 0;
+        int player2Points = 0;
+        int player1Games = 0;
+        int player2Games = 0;
+        int player1Sets = 0;
+        int player2Sets = 0;
+        bool isDeuce = false;
+
+        // Cajas de saque en fracciones de la pantalla, para la mitad de abajo
+        // (la de arriba es simetrica). Las usan isInServiceBox y CourtDrawing.
+        static constexpr float SERVICE_BOX_FRONT = 0.4f;        // borde de la red
+        static constexpr float SERVICE_BOX_BACK = 0.15f;        // linea de saque
+        static constexpr float SERVICE_BOX_HALF_WIDTH = 0.2f;   // desde el centro
+
+        int servingPlayer = 1;
+        bool isDeuceSide = true;
+        int faultCount = 0;
+
+        // Suma el punto y cierra juego/set si corresponde. Devuelve true si se
+        // gano el juego; el llamador decide entre switchServer y el siguiente saque.
+        bool awardPoint(bool player1Won);
+        void switchServer();
+        void alternateServiceSide();
+
+        // Caja de saque a la que tiene que ir el saque actual, en una pantalla
+        // de width x height. isDeuceSide es el lado de la pantalla desde el
+        // que se saca (true = derecha), asi que la caja va en diagonal.
+        bool isInServiceBox(float x, float y, float width, float height) const;
+
+        std::string getPointText() const;
+        std::string getGameText() const;
+    };
+
+}
+
+#endif
\ No newline at end of file
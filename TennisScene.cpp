@@ -1,4 +1,7 @@
 #include "TennisScene.h"
+#include "AudioMixer.h"
+#include "FramePacer.h"
+#include "ShotTable.h"
 
 USING_NS_CC;
 
@@ -8,6 +11,51 @@ namespace EpicGame {
         return TennisScene::create();
     }
 
+    Scene* TennisScene::createReplayExport(const std::string& replayPath, const std::string& outputDir,
+        FrameEncoder::Format format) {
+        std::unique_ptr<ReplayExport> replayExport(new ReplayExport());
+        if (!replayExport->replay.load(replayPath)) {
+            CCLOG("Error: No se pudo leer la repeticion %s", replayPath.c_str());
+            return nullptr;
+        }
+        if (!FileUtils::getInstance()->createDirectory(outputDir)) {
+            CCLOG("Error: No se pudo crear el directorio %s", outputDir.c_str());
+            return nullptr;
+        }
+
+        int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        replayExport->encoder.reset(new FrameEncoder(outputDir, format, threadCount));
+        replayExport->sim.reset(replayExport->replay.getSeed());
+        replayExport->stepper.reset(new MatchStepper<ReplayPlaybackPolicy, ReplayPlaybackPolicy>(replayExport->sim,
+            ReplayPlaybackPolicy(replayExport->replay), ReplayPlaybackPolicy(replayExport->replay)));
+
+        auto scene = new (std::nothrow) TennisScene();
+        if (!scene) {
+            return nullptr;
+        }
+        scene->replayExport = std::move(replayExport);
+        if (!scene->init()) {
+            delete scene;
+            return nullptr;
+        }
+        scene->autorelease();
+        return scene;
+    }
+
+    Scene* TennisScene::createInputLatencyTest(int trials, const std::string& outputPrefix, int stressRate) {
+        auto scene = TennisScene::create();
+        if (!scene) {
+            return nullptr;
+        }
+
+        InputLatencyHarness::Hooks hooks;
+        hooks.prepareTrial = [scene] { scene->prepareLatencyTrial(); };
+        hooks.ballVelocity = [scene] { return scene->velocityOf(scene->ballEntity); };
+        scene->latencyTest.reset(new InputLatencyHarness(trials, outputPrefix, stressRate, hooks));
+        scene->latencyTest->start();
+        return scene;
+    }
+
     bool TennisScene::init() {
         if (!Scene::init()) {
             return false;
@@ -17,11 +65,25 @@ namespace EpicGame {
 
         courtDims.width = visibleSize.width * 0.8f;
         courtDims.height = visibleSize.height * 0.75f;
-        courtDims.serviceLineY = visibleSize.height * 0.4f;
+        courtDims.serviceLineY = visibleSize.height * MatchScore::SERVICE_BOX_FRONT;
         courtDims.serviceBoxWidth = courtDims.width * 0.3f;
         courtDims.netHeight = visibleSize.height * 0.02f;
         courtDims.baselineOffset = visibleSize.height * 0.1f;
         courtDims.sideLineOffset = visibleSize.width * 0.1f;
+        courtGeometry = CourtGeometry::fromVisibleSize(visibleSize.width, visibleSize.height);
+
+        aiSeed = std::random_device()();
+        aiRng.seed(aiSeed % 2147483646u + 1u);
+        CCLOG("Semilla de la IA: %u", aiSeed);
+
+        auto shotTable = ShotTable::getInstance();
+        if (!shotTable->isLoaded() &&
+            !shotTable->load(FileUtils::getInstance()->fullPathForFilename("shot_table.bin"))) {
+            CCLOG("Error: No se pudo cargar shot_table.bin, la IA devolvera al azar");
+        }
+        if (!bounceHeatmap.load(FileUtils::getInstance()->fullPathForFilename("bounce_heatmap.bin"))) {
+            CCLOG("Error: No se pudo cargar bounce_heatmap.bin, el mapa de botes empieza vacio");
+        }
 
         float courtCenter = visibleSize.width / 2;
         float frontY = visibleSize.height * 0.15f;
@@ -40,6 +102,39 @@ namespace EpicGame {
         initUI();
 
         positionPlayersForServe();
+        syncSprites();
+
+        events.subscribe([this](const MatchEvent& event) { onScoreEvent(event); });
+        events.subscribe([this](const MatchEvent& event) {
+            if (event.type == MatchEventType::BOUNCE) {
+                bounceHeatmap.add(event.x / courtGeometry.width, event.y / courtGeometry.height);
+                heatmapDirty = true;
+            }
+        });
+        events.subscribe([this](const MatchEvent& event) {
+            if (event.type == MatchEventType::POINT_WON && crowd) {
+                crowd->cheer(event.player);
+            }
+        });
+        events.subscribe([](const MatchEvent& event) {
+            CCLOG("Evento %s jugador %d (%.0f, %.0f)", getEventName(event.type), event.player, event.x, event.y);
+        });
+
+        if (replayExport) {
+            replayExport->target = RenderTexture::create(static_cast<int>(visibleSize.width),
+                static_cast<int>(visibleSize.height), Texture2D::PixelFormat::RGBA8888);
+            if (!replayExport->target) {
+                CCLOG("Error: No se pudo crear la textura de exportacion");
+                return false;
+            }
+            replayExport->target->retain();
+            replayExport->startTime = utils::gettime();
+            CCLOG("Exportando %zu frames de repeticion", replayExport->replay.size());
+            scheduleUpdate();
+            return true;
+        }
+
+        startServeSequence();
 
         auto keyListener = EventListenerKeyboard::create();
         keyListener->onKeyPressed = CC_CALLBACK_2(TennisScene::onKeyPressed, this);
@@ -52,47 +147,127 @@ namespace EpicGame {
     void TennisScene::initCourt() {
         auto visibleSize = Director::getInstance()->getVisibleSize();
 
-        court = Sprite::create("court.png");
+        court = CourtDrawing::create(courtGeometry, courtDims.netHeight);
         if (court) {
-            court->setPosition(visibleSize.width / 2, visibleSize.height / 2);
-            court->setScale(visibleSize.width / court->getContentSize().width,
-                visibleSize.height / court->getContentSize().height);
             this->addChild(court, 0);
         }
+        else {
+            CCLOG("Error: No se pudo crear la pista");
+        }
+
+        // Gradas: los laterales fuera de la pista y el fondo detras de player2.
+        float standWidth = (visibleSize.width - courtDims.width) / 2;
+        float topStandY = visibleSize.height * 0.93f;
+        std::vector<Rect> stands = {
+            Rect(0, 0, standWidth, topStandY),
+            Rect(visibleSize.width - standWidth, 0, standWidth, topStandY),
+            Rect(0, topStandY, visibleSize.width, visibleSize.height - topStandY)
+        };
+        crowd = CrowdLayer::create(stands, CROWD_SIZE, aiSeed);
+        if (crowd) {
+            this->addChild(crowd, 0);
+        }
+        else {
+            CCLOG("Error: No se pudo crear el publico");
+        }
     }
 
     void TennisScene::initPlayers() {
-        player1 = Sprite::create("player1.png");
-        player2 = Sprite::create("player2.png");
+        auto player1 = Sprite::create("player1.png");
+        auto player2 = Sprite::create("player2.png");
 
         if (player1 && player2) {
-            player1->setScale(FRONT_PLAYER_SCALE);
-            player2->setScale(BACK_PLAYER_SCALE);
-
-            this->addChild(player1, 2);
-            this->addChild(player2, 2);
+            player1Entity = addEntity(player1, EntityStore::TRANSFORM | EntityStore::CONTROLLER, 2);
+            world.transforms[player1Entity].scale = FRONT_PLAYER_SCALE;
+            world.controllers[player1Entity].type = ControllerType::KEYBOARD;
+            world.controllers[player1Entity].team = 1;
+            world.controllers[player1Entity].speed = PLAYER_SPEED;
+
+            player2Entity = addEntity(player2, EntityStore::TRANSFORM | EntityStore::CONTROLLER, 2);
+            world.transforms[player2Entity].scale = BACK_PLAYER_SCALE;
+            world.controllers[player2Entity].type = ControllerType::AI;
+            world.controllers[player2Entity].team = 2;
+            world.controllers[player2Entity].speed = AI_SPEED * 0.85f;
         }
     }
 
     void TennisScene::initBall() {
-        ball = Sprite::create("ball.png");
+        auto ball = Sprite::create("ball.png");
         if (ball) {
-            ball->setScale(BALL_BASE_SCALE);
+            ballEntity = addEntity(ball, EntityStore::TRANSFORM | EntityStore::VELOCITY | EntityStore::SHADOW_LINK, 2);
+            world.transforms[ballEntity].scale = BALL_BASE_SCALE;
             resetBall();
-            this->addChild(ball, 2);
         }
     }
 
     void TennisScene::initShadows() {
-        ballShadow = Sprite::create("ball_shadow.png");
-        if (ballShadow) {
-            ballShadow->setScale(BALL_BASE_SCALE * 0.7f);
+        auto ballShadow = Sprite::create("ball_shadow.png");
+        if (ballShadow && ballEntity >= 0) {
             ballShadow->setOpacity(150);
             ballShadow->setColor(Color3B(0, 0, 0));
-            this->addChild(ballShadow, 1);
+            shadowEntity = addEntity(ballShadow, EntityStore::TRANSFORM, 1);
+            world.transforms[shadowEntity].scale = BALL_BASE_SCALE * 0.7f;
+            world.shadowLinks[ballEntity].shadow = shadowEntity;
         }
     }
 
+    void TennisScene::toggleHeatmap() {
+        if (heatmapOverlay) {
+            heatmapOverlay->setVisible(!heatmapOverlay->isVisible());
+            if (heatmapOverlay->isVisible() && heatmapDirty) {
+                updateHeatmapTexture();
+            }
+            return;
+        }
+
+        std::vector<uint8_t> pixels;
+        bounceHeatmap.toRGBA(pixels);
+        auto texture = new Texture2D();
+        if (!texture->initWithData(pixels.data(), pixels.size(), Texture2D::PixelFormat::RGBA8888,
+            BounceHeatmap::BINS_X, BounceHeatmap::BINS_Y, Size(BounceHeatmap::BINS_X, BounceHeatmap::BINS_Y))) {
+            CCLOG("Error: No se pudo crear la textura del mapa de botes");
+            texture->release();
+            return;
+        }
+        texture->setAntiAliasTexParameters();
+
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+        heatmapOverlay = Sprite::createWithTexture(texture);
+        texture->release();
+        heatmapOverlay->setPosition(visibleSize.width / 2, visibleSize.height / 2);
+        heatmapOverlay->setScale(visibleSize.width / BounceHeatmap::BINS_X, visibleSize.height / BounceHeatmap::BINS_Y);
+        this->addChild(heatmapOverlay, 0);
+        heatmapDirty = false;
+    }
+
+    void TennisScene::updateHeatmapTexture() {
+        std::vector<uint8_t> pixels;
+        bounceHeatmap.toRGBA(pixels);
+        heatmapOverlay->getTexture()->updateWithData(pixels.data(), 0, 0, BounceHeatmap::BINS_X, BounceHeatmap::BINS_Y);
+        heatmapDirty = false;
+    }
+
+    int TennisScene::addEntity(cocos2d::Sprite* sprite, uint8_t components, int zOrder) {
+        int entity = world.createEntity(components);
+        this->addChild(sprite, zOrder);
+        sprites.add(sprite);
+        return entity;
+    }
+
+    void TennisScene::syncSprites() {
+        for (int entity = 0; entity < world.size(); entity++) {
+            const Transform& transform = world.transforms[entity];
+            sprites.setPosition(entity, transform.position);
+            sprites.setScale(entity, transform.scale);
+        }
+        // Con efecto la pelota se dibuja a su altura sobre la sombra.
+        if (ballEntity >= 0 && spinFlight.height > 0.0f) {
+            float pixelsPerMetre = (courtGeometry.height - 2.0f * courtGeometry.baselineOffset) / SpinTable::COURT_LENGTH;
+            sprites.setPosition(ballEntity, positionOf(ballEntity) + Vec2(0.0f, spinFlight.height * pixelsPerMetre));
+        }
+        sprites.flush();
+    }
+
     void TennisScene::initUI() {
         auto visibleSize = Director::getInstance()->getVisibleSize();
 
@@ -115,287 +290,473 @@ namespace EpicGame {
         updateScoreDisplay();
     }
     void EpicGame::TennisScene::update(float delta) {
+        stepTime = AudioMixer::getTime();
+        if (replayExport) {
+            updateReplayExport();
+            return;
+        }
+
         switch (gameState) {
         case GameState::SERVE:
-            if (servingPlayer == 2) {
-                aiServeTimer += delta;
-
-                switch (serveState) {
-                case ServeState::READY:
-                    if (aiServeTimer > 1.0f) {
-                        serveState = ServeState::TOSS;
-                        aiServeTimer = 0;
-                        ballVelocity = cocos2d::Vec2::ZERO;
-                    }
-                    break;
+        case GameState::POINT_END:
+            sequences.tick(delta);
+            break;
 
-                case ServeState::TOSS:
-                {
-                    float progress = aiServeTimer / SERVE_DURATION;
-                    if (progress <= 1.0f) {
-                        float height = SERVE_HEIGHT * (1 - (2 * progress - 1) * (2 * progress - 1));
-                        float xOffset = 10.0f * sin(progress * M_PI);
-                        cocos2d::Vec2 ballPos(player2->getPositionX() + xOffset,
-                            player2->getPositionY() - SERVE_START_HEIGHT - height);
-
-                        ball->setPosition(ballPos);
-                        updateBallShadow();
-
-                        if (progress > 0.5f && progress < 0.8f) {
-                            serveState = ServeState::READY_TO_HIT;
-                            canServe = true;
-                            hitServe();
-                        }
-                    }
-                    else {
-                        serveState = ServeState::FALLING;
-                        ballVelocity = cocos2d::Vec2::ZERO;
-                        canServe = false;
-                    }
-                }
-                break;
+        case GameState::PLAY:
+            updateKeyboardControllers(delta);
+            updateBalls(delta);
+            updateAIControllers(delta);
+            updateShadows();
+            // Si el bote de updateBalls ya cerro el punto, la pelota esta en
+            // la mano del siguiente saque y no hay que volver a mirarla.
+            if (gameState == GameState::PLAY) {
+                checkCourtBoundaries();
+            }
+            break;
 
-                case ServeState::FALLING:
-                    ballVelocity.y -= GRAVITY * delta;
-                    cocos2d::Vec2 pos = ball->getPosition();
-                    pos += ballVelocity * delta;
-                    ball->setPosition(pos);
-
-                    if (pos.y >= player2->getPositionY() - SERVE_START_HEIGHT) {
-                        faultCount++;
-                        if (faultCount >= 2) {
-                            handlePointEnd(true);
-                        }
-                        else {
-                            resetServe();
-                        }
-                    }
-                    break;
-                }
+        }
+
+        syncSprites();
+        recordFrame(delta);
+        events.dispatch();
+        updateFramePacing();
+        if (heatmapDirty && heatmapOverlay && heatmapOverlay->isVisible()) {
+            updateHeatmapTexture();
+        }
+
+        const Vec2& ballPos = positionOf(ballEntity);
+        if (gameState == GameState::PLAY && recorder.shouldAutoDump() &&
+            (ballPos.x < 0 || ballPos.x > courtGeometry.width || ballPos.y < 0 || ballPos.y > courtGeometry.height)) {
+            dumpFlightRecorder("Pelota fuera de la pantalla");
+        }
+    }
+
+    void TennisScene::updateFramePacing() {
+        FramePacer::Activity activity = FramePacer::Activity::NORMAL;
+        if (gameState == GameState::PLAY) {
+            activity = FramePacer::Activity::RALLY;
+        }
+        else if (gameState == GameState::POINT_END) {
+            activity = FramePacer::Activity::IDLE;
+        }
+        else if (isServing && serveState == ServeState::READY) {
+            // Esperando el saque de player1 no se mueve nada salvo el publico;
+            // la IA solo cuenta su espera antes de lanzar.
+            bool waitingPlayer = score.servingPlayer == 1 && !(crowd && crowd->isCheering());
+            activity = waitingPlayer ? FramePacer::Activity::STOPPED : FramePacer::Activity::IDLE;
+        }
+        FramePacer::getInstance()->setActivity(activity);
+    }
+
+    void TennisScene::recordFrame(float delta) {
+        FlightFrame& frame = recorder.nextFrame();
+        frame.frame = frameIndex++;
+        frame.delta = delta;
+        frame.ballX = positionOf(ballEntity).x;
+        frame.ballY = positionOf(ballEntity).y;
+        frame.ballVX = velocityOf(ballEntity).x;
+        frame.ballVY = velocityOf(ballEntity).y;
+        frame.player1X = positionOf(player1Entity).x;
+        frame.player2X = positionOf(player2Entity).x;
+        frame.gameState = static_cast<uint8_t>(gameState);
+        frame.serveState = static_cast<uint8_t>(serveState);
+        frame.input = (leftPressed ? FlightFrame::INPUT_LEFT : 0) |
+            (rightPressed ? FlightFrame::INPUT_RIGHT : 0) |
+            (upPressed ? FlightFrame::INPUT_UP : 0) |
+            (downPressed ? FlightFrame::INPUT_DOWN : 0) |
+            (spacePressed ? FlightFrame::INPUT_SPACE : 0);
+        frame.faultCount = static_cast<uint8_t>(score.faultCount);
+        frame.player1Points = static_cast<uint8_t>(score.player1Points);
+        frame.player2Points = static_cast<uint8_t>(score.player2Points);
+        frame.player1Games = static_cast<uint8_t>(score.player1Games);
+        frame.player2Games = static_cast<uint8_t>(score.player2Games);
+        frame.player1Sets = static_cast<uint8_t>(score.player1Sets);
+        frame.player2Sets = static_cast<uint8_t>(score.player2Sets);
+        frame.servingPlayer = static_cast<uint8_t>(score.servingPlayer);
+        frame.isDeuceSide = score.isDeuceSide ? 1 : 0;
+
+        StateHasher hasher;
+        hasher.add(frame.ballX);
+        hasher.add(frame.ballY);
+        hasher.add(frame.ballVX);
+        hasher.add(frame.ballVY);
+        hasher.add(frame.player1X);
+        hasher.add(frame.player2X);
+        hasher.add(positionOf(player1Entity).y);
+        hasher.add(positionOf(player2Entity).y);
+        hasher.add(serveTimer);
+        hasher.add(static_cast<uint64_t>(frame.gameState) | static_cast<uint64_t>(frame.serveState) << 8 |
+            static_cast<uint64_t>(frame.faultCount) << 16 | static_cast<uint64_t>(frame.servingPlayer) << 24 |
+            static_cast<uint64_t>(frame.isDeuceSide) << 32 | static_cast<uint64_t>(ballInPlay) << 40 |
+            static_cast<uint64_t>(canHit) << 48 | static_cast<uint64_t>(canServe) << 56);
+        hasher.add(static_cast<uint64_t>(frame.player1Points) | static_cast<uint64_t>(frame.player2Points) << 8 |
+            static_cast<uint64_t>(frame.player1Games) << 16 | static_cast<uint64_t>(frame.player2Games) << 24 |
+            static_cast<uint64_t>(frame.player1Sets) << 32 | static_cast<uint64_t>(frame.player2Sets) << 40 |
+            static_cast<uint64_t>(score.isDeuce) << 48);
+        frame.stateHash = hasher.finish();
+    }
+
+    void TennisScene::updateReplayExport() {
+        ReplayExport& exporter = *replayExport;
+        if (!exporter.encoder) {
+            return;
+        }
+
+        // No depende del delta del Director: se renderizan frames de video
+        // hasta agotar el presupuesto del tick.
+        double tickStart = utils::gettime();
+        do {
+            if (exporter.frame >= exporter.replay.size()) {
+                exporter.encoder->finish();
+                double seconds = utils::gettime() - exporter.startTime;
+                CCLOG("Exportados %u frames (%u con error) en %.1f s, %.1fx tiempo real",
+                    exporter.encoder->getWrittenCount(), exporter.encoder->getFailedCount(), seconds,
+                    seconds > 0.0 ? exporter.videoTime / seconds : 0.0);
+                exporter.encoder.reset();
+                Director::getInstance()->end();
+                return;
             }
-            else {
-                updateServe(delta);
+
+            while (exporter.frame < exporter.replay.size() && exporter.replayTime <= exporter.videoTime) {
+                float frameDelta = exporter.replay.getFrame(exporter.frame).delta;
+                exporter.stepper->step(frameDelta);
+                exporter.replayTime += frameDelta;
+                exporter.frame++;
             }
-            break;
 
-        case GameState::PLAY:
-            updatePlayerPosition(delta);
-            updateBallPhysics(delta);
-            updateAI(delta);
-            updateBallShadow();
-            checkCourtBoundaries();
-            break;
+            applyReplayState(exporter.sim.getState(), exporter.sim.getCourt());
+            captureExportFrame();
+            exporter.videoTime += EXPORT_FRAME_TIME;
+        } while (utils::gettime() - tickStart < EXPORT_TICK_BUDGET);
+    }
 
-        case GameState::POINT_END:
-            startNewPoint();
-            gameState = GameState::SERVE;
-            break;
+    void TennisScene::applyReplayState(const MatchSim::State& state, const CourtGeometryT<Scalar>& simCourt) {
+        float scaleX = courtGeometry.width / toFloat(simCourt.width);
+        float scaleY = courtGeometry.height / toFloat(simCourt.height);
+
+        positionOf(ballEntity) = Vec2(toFloat(state.ball.x) * scaleX, toFloat(state.ball.y) * scaleY);
+        velocityOf(ballEntity) = Vec2(toFloat(state.ball.vx) * scaleX, toFloat(state.ball.vy) * scaleY);
+        positionOf(player1Entity) = Vec2(toFloat(state.player1X) * scaleX, toFloat(state.player1Y) * scaleY);
+        positionOf(player2Entity) = Vec2(toFloat(state.player2X) * scaleX, toFloat(state.player2Y) * scaleY);
+        ballInPlay = state.ballInPlay;
+        spinFlight.height = toFloat(state.spin.height);     // solo para dibujar
+        updateShadows();
+
+        score = state.score;
+        updateScoreDisplay();
+        syncSprites();
+    }
+
+    void TennisScene::captureExportFrame() {
+        ReplayExport& exporter = *replayExport;
+        exporter.target->beginWithClear(0.0f, 0.0f, 0.0f, 1.0f);
+        visit();
+        exporter.target->end();
+        Director::getInstance()->getRenderer()->render();
+
+        Image* image = exporter.target->newImage(true);
+        if (!image) {
+            CCLOG("Error: No se pudo leer el frame %u", exporter.videoFrame);
+            exporter.videoFrame++;
+            return;
+        }
+        exporter.encoder->submit(exporter.videoFrame++, image->getData(), image->getWidth(), image->getHeight());
+        image->release();
+    }
+
+    void TennisScene::prepareLatencyTrial() {
+        // Pelota bajando justo delante de player1, dentro del alcance de onKeyPressed.
+        sequences.cancelAll();
+        gameState = GameState::PLAY;
+        isServing = false;
+        serveState = ServeState::READY;
+        ballInPlay = true;
+        leftPressed = rightPressed = upPressed = downPressed = spacePressed = false;
+
+        const Vec2& playerPos = positionOf(player1Entity);
+        positionOf(ballEntity) = Vec2(playerPos.x, playerPos.y + HIT_DISTANCE);
+        velocityOf(ballEntity) = Vec2(0.0f, -150.0f);
+        updateShadows();
+        syncSprites();
+    }
+
+    void TennisScene::dumpFlightRecorder(const std::string& reason) {
+        std::string path = FileUtils::getInstance()->getWritablePath() +
+            "flight_" + std::to_string(frameIndex) + ".csv";
+        if (recorder.dump(path, reason)) {
+            CCLOG("Grabacion de vuelo (%s) guardada en %s", reason.c_str(), path.c_str());
+        }
+        else {
+            CCLOG("Error: No se pudo guardar la grabacion de vuelo en %s", path.c_str());
         }
+        recorder.markDumped();
     }
 
-    void TennisScene::updatePlayerPosition(float delta) {
-        if (!isServing || serveState != ServeState::READY) {
-            Vec2 pos = player1->getPosition();
-            float moveSpeed = PLAYER_SPEED * delta;
+    void TennisScene::updateKeyboardControllers(float delta) {
+        if (isServing && serveState == ServeState::READY) return;
+
+        auto visibleSize = Director::getInstance()->getVisibleSize();
+
+        for (int entity = 0; entity < world.size(); entity++) {
+            if (!world.has(entity, EntityStore::TRANSFORM | EntityStore::CONTROLLER) ||
+                world.controllers[entity].type != ControllerType::KEYBOARD) {
+                continue;
+            }
+
+            Vec2& pos = world.transforms[entity].position;
+            float moveSpeed = world.controllers[entity].speed * delta;
 
             if (leftPressed) pos.x -= moveSpeed;
             if (rightPressed) pos.x += moveSpeed;
 
-            auto visibleSize = Director::getInstance()->getVisibleSize();
-            float minX = (visibleSize.width - courtDims.width) / 2 +
-                player1->getContentSize().width * player1->getScale() / 2;
-            float maxX = (visibleSize.width + courtDims.width) / 2 -
-                player1->getContentSize().width * player1->getScale() / 2;
+            float halfWidth = spriteOf(entity)->getContentSize().width * world.transforms[entity].scale / 2;
+            float minX = (visibleSize.width - courtDims.width) / 2 + halfWidth;
+            float maxX = (visibleSize.width + courtDims.width) / 2 - halfWidth;
 
             pos.x = std::min(std::max(pos.x, minX), maxX);
-            player1->setPosition(pos);
         }
     }
-    void TennisScene::updateBallPhysics(float delta) {
-        if (!ballInPlay) return;
-
-        auto visibleSize = Director::getInstance()->getVisibleSize();
-        ballVelocity.y -= GRAVITY * delta * 0.15f;
-        ballVelocity.x *= 0.997f;
 
-        cocos2d::Vec2 newPos = ball->getPosition() + ballVelocity * delta;
+    void TennisScene::updateBalls(float delta) {
+        if (!ballInPlay) return;
 
         float hitDistance = 150.0f;
         float verticalHitDistance = 180.0f;
 
-        bool nearPlayer1 = (std::abs(newPos.x - player1->getPositionX()) < hitDistance &&
-            std::abs(newPos.y - player1->getPositionY()) < verticalHitDistance);
+        for (int entity = 0; entity < world.size(); entity++) {
+            if (!world.has(entity, EntityStore::TRANSFORM | EntityStore::VELOCITY)) {
+                continue;
+            }
 
-        canHit = nearPlayer1;
+            Vec2& pos = world.transforms[entity].position;
+            Vec2& velocity = world.velocities[entity].value;
 
-        float netY = visibleSize.height * 0.5f;
-        float netThickness = visibleSize.height * 0.02f;
+            BallState state;
+            state.x = pos.x;
+            state.y = pos.y;
+            state.vx = velocity.x;
+            state.vy = velocity.y;
 
-        if (ball->getPositionY() >= netY - netThickness &&
-            ball->getPositionY() <= netY + netThickness &&
-            std::abs(ball->getPositionX() - visibleSize.width * 0.5f) < 10.0f) {
+            bool player1Won = false;
+            FlightResult result = entity == ballEntity && spinFlight.shot != ShotType::NORMAL ?
+                SpinTable::step(state, spinFlight, delta, courtGeometry, player1Won) :
+                BallFlight::step(state, delta, courtGeometry, player1Won);
+            velocity.set(state.vx, state.vy);
 
-            bool lastHitByPlayer1 = ballVelocity.y > 0;
-            handlePointEnd(lastHitByPlayer1);
-            return;
-        }
+            if (result != FlightResult::IN_PLAY) {
+                if (result != FlightResult::NET) {
+                    publishEvent(MatchEventType::BOUNCE, state.y < courtGeometry.height * 0.5f ? 1 : 2);
+                }
+                handlePointEnd(player1Won);
+                return;
+            }
 
-        if (newPos.y < visibleSize.height * 0.05f || newPos.y > visibleSize.height * 0.95f) {
-            handlePointEnd(newPos.y < visibleSize.height * 0.5f);
-            return;
-        }
+            canHit = false;
+            for (int player = 0; player < world.size(); player++) {
+                if (world.has(player, EntityStore::TRANSFORM | EntityStore::CONTROLLER) &&
+                    world.controllers[player].type == ControllerType::KEYBOARD) {
+                    const Vec2& playerPos = world.transforms[player].position;
+                    canHit = canHit || (std::abs(state.x - playerPos.x) < hitDistance &&
+                        std::abs(state.y - playerPos.y) < verticalHitDistance);
+                }
+            }
 
-        if (newPos.x < visibleSize.width * 0.1f || newPos.x > visibleSize.width * 0.9f) {
-            handlePointEnd(newPos.y > visibleSize.height * 0.5f);
-            return;
+            pos.set(state.x, state.y);
         }
+    }
 
-        float minSpeed = 100.0f;
-        float currentSpeed = sqrt(ballVelocity.x * ballVelocity.x + ballVelocity.y * ballVelocity.y);
-        if (currentSpeed < minSpeed && ballInPlay) {
-            handlePointEnd(ball->getPositionY() < visibleSize.height * 0.5f);
-            return;
-        }
+    Sequence TennisScene::playerServeSequence() {
+        for (;;) {
+            positionOf(ballEntity) = cocos2d::Vec2(positionOf(player1Entity).x,
+                positionOf(player1Entity).y + SERVE_START_HEIGHT);
+            sprites.setVisible(shadowEntity, false);
 
-        ball->setPosition(newPos);
-        updateBallShadow();
-    }
+            // El lanzamiento lo empieza onKeyPressed; el golpe tambien, y
+            // hitServe cancela esta secuencia.
+            float delta = co_await sequences.until([this] { return serveState != ServeState::READY; });
 
-    void EpicGame::TennisScene::updateServe(float delta) {
-        switch (serveState) {
-        case ServeState::READY: {
-            ball->setPosition(player1->getPositionX(),
-                player1->getPositionY() + SERVE_START_HEIGHT);
-            ballShadow->setVisible(false);
-            break;
-        }
-        case ServeState::TOSS: {
-            serveTimer += delta;
-            float progress = serveTimer / SERVE_DURATION;
+            for (;;) {
+                serveTimer += delta;
+                float progress = serveTimer / SERVE_DURATION;
+                if (progress > 1.0f) {
+                    break;
+                }
 
-            if (progress <= 1.0f) {
                 float height = SERVE_HEIGHT * (1 - (2 * progress - 1) * (2 * progress - 1));
                 float xOffset = 10.0f * sin(progress * M_PI);
-                cocos2d::Vec2 ballPos(player1->getPositionX() + xOffset,
-                    player1->getPositionY() + SERVE_START_HEIGHT + height);
-
-                ball->setPosition(ballPos);
-                updateBallShadow();
+                positionOf(ballEntity) = cocos2d::Vec2(positionOf(player1Entity).x + xOffset,
+                    positionOf(player1Entity).y + SERVE_START_HEIGHT + height);
+                updateShadows();
 
                 if (progress > 0.5f && progress < 0.8f) {
                     serveState = ServeState::READY_TO_HIT;
                     canServe = true;
                 }
+                else if (canServe) {
+                    serveState = ServeState::TOSS;
+                    canServe = false;
+                }
+                delta = co_await sequences.nextFrame();
             }
-            else {
-                serveState = ServeState::FALLING;
-                ballVelocity = cocos2d::Vec2::ZERO;
-                canServe = false;
+
+            serveState = ServeState::FALLING;
+            velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
+            canServe = false;
+            for (;;) {
+                delta = co_await sequences.nextFrame();
+                velocityOf(ballEntity).y += GRAVITY * delta;
+                positionOf(ballEntity) += velocityOf(ballEntity) * delta;
+                updateShadows();
+                if (positionOf(ballEntity).y <= positionOf(player1Entity).y + SERVE_START_HEIGHT) {
+                    break;
+                }
             }
-            break;
+
+            publishEvent(MatchEventType::FAULT, 1);
+            score.faultCount++;
+            if (score.faultCount >= 2) {
+                handlePointEnd(false);
+                co_return;
+            }
+            resetServe();
         }
-        case ServeState::FALLING: {
-            ballVelocity.y += GRAVITY * delta;
-            cocos2d::Vec2 pos = ball->getPosition() + ballVelocity * delta;
-            ball->setPosition(pos);
-            updateBallShadow();
+    }
 
-            if (pos.y <= player1->getPositionY() + SERVE_START_HEIGHT) {
-                faultCount++;
-                if (faultCount >= 2) {
-                    handlePointEnd(false);
+    Sequence TennisScene::aiServeSequence() {
+        for (;;) {
+            co_await sequences.delay(AI_SERVE_DELAY);
+            serveState = ServeState::TOSS;
+            serveTimer = 0;
+            velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
+
+            for (;;) {
+                serveTimer += co_await sequences.nextFrame();
+                float progress = serveTimer / SERVE_DURATION;
+                if (progress > 1.0f) {
+                    break;
                 }
-                else {
-                    resetServe();
+
+                float height = SERVE_HEIGHT * (1 - (2 * progress - 1) * (2 * progress - 1));
+                float xOffset = 10.0f * sin(progress * M_PI);
+                positionOf(ballEntity) = cocos2d::Vec2(positionOf(player2Entity).x + xOffset,
+                    positionOf(player2Entity).y - SERVE_START_HEIGHT - height);
+                updateShadows();
+
+                if (progress > 0.5f && progress < 0.8f) {
+                    serveState = ServeState::READY_TO_HIT;
+                    canServe = true;
+                    hitServe();
+                    co_return;
                 }
             }
-            break;
+
+            serveState = ServeState::FALLING;
+            velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
+            canServe = false;
+            for (;;) {
+                float delta = co_await sequences.nextFrame();
+                velocityOf(ballEntity).y -= GRAVITY * delta;
+                positionOf(ballEntity) += velocityOf(ballEntity) * delta;
+                if (positionOf(ballEntity).y >= positionOf(player2Entity).y - SERVE_START_HEIGHT) {
+                    break;
+                }
+            }
+
+            publishEvent(MatchEventType::FAULT, 2);
+            score.faultCount++;
+            if (score.faultCount >= 2) {
+                handlePointEnd(true);
+                co_return;
+            }
+            resetServe();
         }
-        default:
-            break;
+    }
+
+    Sequence TennisScene::pointEndSequence() {
+        co_await sequences.delay(POINT_END_DELAY);
+        startNewPoint();
+        gameState = GameState::SERVE;
+        startServeSequence();
+    }
+
+    void TennisScene::startServeSequence() {
+        sequences.cancelAll();
+        if (score.servingPlayer == 2) {
+            sequences.start(aiServeSequence());
+        }
+        else {
+            sequences.start(playerServeSequence());
         }
     }
-    void TennisScene::updateAI(float delta) {
+
+    void TennisScene::updateAIControllers(float delta) {
         if (!ballInPlay) return;
 
         auto visibleSize = Director::getInstance()->getVisibleSize();
-        cocos2d::Vec2 ballPos = ball->getPosition();
-        cocos2d::Vec2 aiPos = player2->getPosition();
-
-        if (gameState == GameState::SERVE && servingPlayer == 2) {
-            aiServeTimer += delta;
-
-            switch (serveState) {
-            case ServeState::READY:
-                ball->setPosition(aiPos.x, aiPos.y + SERVE_START_HEIGHT);
-                ballInPlay = true;
-                if (aiServeTimer > 1.0f) {
-                    serveState = ServeState::TOSS;
-                    aiServeTimer = 0;
-                }
-                break;
+        float minHitDepth = visibleSize.height * 0.7f;
+        float hitRangeX = 60.0f;
 
-            case ServeState::TOSS:
-                float progress = aiServeTimer / SERVE_DURATION;
-                if (progress <= 1.0f) {
-                    float height = SERVE_HEIGHT * (1 - (2 * progress - 1) * (2 * progress - 1));
-                    cocos2d::Vec2 ballPos(aiPos.x, aiPos.y + SERVE_START_HEIGHT + height);
-                    ball->setPosition(ballPos);
-                    updateBallShadow();
+        for (int entity = 0; entity < world.size(); entity++) {
+            if (!world.has(entity, EntityStore::TRANSFORM | EntityStore::CONTROLLER) ||
+                world.controllers[entity].type != ControllerType::AI) {
+                continue;
+            }
 
-                    if (progress > 0.5f && progress < 0.8f && gameState == GameState::SERVE) {
-                        float targetX = visibleSize.width * 0.75f;
-                        cocos2d::Vec2 direction(-2.0f, -2.0f);
-                        direction.normalize();
+            // La IA razona como si jugara arriba; el equipo de abajo se refleja en vertical.
+            const Controller& controller = world.controllers[entity];
+            bool top = controller.team == 2;
+            Vec2& aiPos = world.transforms[entity].position;
+            float baselineY = top ? visibleSize.height * 0.85f : visibleSize.height * 0.15f;
 
-                        ballVelocity = direction * SERVE_SPEED;
-                        gameState = GameState::PLAY;
-                    }
+            int target = -1;
+            for (int ball = 0; ball < world.size(); ball++) {
+                if (!world.has(ball, EntityStore::TRANSFORM | EntityStore::VELOCITY)) {
+                    continue;
+                }
+                float depth = top ? world.transforms[ball].position.y : visibleSize.height - world.transforms[ball].position.y;
+                if (depth > visibleSize.height * 0.5f &&
+                    (target < 0 || std::abs(world.transforms[ball].position.x - aiPos.x) <
+                        std::abs(world.transforms[target].position.x - aiPos.x))) {
+                    target = ball;
                 }
-                break;
             }
-            return;
-        }
-
-        float baselineY = visibleSize.height * 0.85f;
-        float minHitY = visibleSize.height * 0.7f;
-        float hitRangeX = 60.0f;
-
-        if (ballPos.y > visibleSize.height * 0.5f) {
-            float targetX = ballPos.x;
-            float currentX = aiPos.x;
+            if (target < 0) {
+                continue;
+            }
 
-            if (std::abs(targetX - currentX) > 10.0f) {
-                float direction = (targetX > currentX) ? 1.0f : -1.0f;
-                cocos2d::Vec2 newPos = aiPos;
-                float aiSpeed = AI_SPEED * 0.85f;
-                newPos.x += direction * aiSpeed * delta;
+            Vec2 ballPos = world.transforms[target].position;
+            Vec2& ballVelocity = world.velocities[target].value;
+            float ballDepth = top ? ballPos.y : visibleSize.height - ballPos.y;
 
+            if (std::abs(ballPos.x - aiPos.x) > 10.0f) {
+                float direction = (ballPos.x > aiPos.x) ? 1.0f : -1.0f;
                 float minX = visibleSize.width * 0.1f;
                 float maxX = visibleSize.width * 0.9f;
-                newPos.x = std::min(std::max(newPos.x, minX), maxX);
-                newPos.y = baselineY;
-
-                if (rand() % 100 < 25) {
-                    player2->setPosition(newPos);
-                }
-                else {
-                    player2->setPosition(newPos);
-                }
+                aiPos.x = std::min(std::max(aiPos.x + direction * controller.speed * delta, minX), maxX);
+                aiPos.y = baselineY;
             }
 
-            if (ballPos.y >= minHitY && std::abs(ballPos.x - aiPos.x) < hitRangeX) {
-                if (rand() % 100 < 75) {
+            if (isBallReachable() && ballDepth >= minHitDepth && std::abs(ballPos.x - aiPos.x) < hitRangeX) {
+                if (aiRng() % 100 < 75) {
                     cocos2d::Vec2 direction;
-                    direction.y = -2.0f;
+                    direction.y = top ? -2.0f : 2.0f;
 
-                    float randomOffset = (rand() % 300 - 150) / 100.0f;
-                    float targetX = player1->getPositionX() + randomOffset * visibleSize.width * 0.15f;
+                    float targetX;
+                    float hitSpeed = 550.0f;
+                    if (ShotTable::getInstance()->lookup(ballPos.x / visibleSize.width, ballDepth / visibleSize.height,
+                        ballVelocity.x, top ? ballVelocity.y : -ballVelocity.y, aiPos.x / visibleSize.width, targetX, hitSpeed)) {
+                        targetX *= visibleSize.width;
+                    }
+                    else {
+                        float randomOffset = (static_cast<int>(aiRng() % 300) - 150) / 100.0f;
+                        targetX = findOpponentX(controller.team) + randomOffset * visibleSize.width * 0.15f;
+                    }
                     direction.x = (targetX - ballPos.x) / (visibleSize.width * 0.5f);
 
                     direction.normalize();
-                    float hitSpeed = 550.0f;
                     ballVelocity = direction * hitSpeed;
+                    spinFlight = SpinFlight();
+                    publishEvent(MatchEventType::SHOT_HIT, controller.team);
 
                     hasBounced = false;
                     hasBouncedInOpponentCourt = false;
@@ -403,12 +764,23 @@ namespace EpicGame {
             }
         }
     }
+
+    float TennisScene::findOpponentX(int team) {
+        for (int entity = 0; entity < world.size(); entity++) {
+            if (world.has(entity, EntityStore::TRANSFORM | EntityStore::CONTROLLER) &&
+                world.controllers[entity].team != team) {
+                return world.transforms[entity].position.x;
+            }
+        }
+        return Director::getInstance()->getVisibleSize().width * 0.5f;
+    }
+
     void TennisScene::executeShot(ShotType type) {
-        if (!canHit) return;
+        if (!canHit || !isBallReachable()) return;
 
         auto visibleSize = Director::getInstance()->getVisibleSize();
-        cocos2d::Vec2 ballPos = ball->getPosition();
-        cocos2d::Vec2 playerPos = player1->getPosition();
+        cocos2d::Vec2 ballPos = positionOf(ballEntity);
+        cocos2d::Vec2 playerPos = positionOf(player1Entity);
 
         if (std::abs(ballPos.x - playerPos.x) < 50.0f) {
             cocos2d::Vec2 direction;
@@ -426,48 +798,72 @@ namespace EpicGame {
             direction.normalize();
 
             float speed = 600.0f;
+            switch (type) {
+            case ShotType::TOPSPIN:
+                speed = HIT_SPEED;
+                ballSpin = BALL_SPIN;
+                break;
+            case ShotType::SLICE:
+                speed = HIT_BASE_SPEED;
+                ballSpin = BALL_SPIN;
+                break;
+            case ShotType::LOB:
+                speed = LOB_SPEED;
+                ballSpin = BALL_SPIN * 0.5f;
+                break;
+            case ShotType::SMASH:
+                speed = SMASH_SPEED;
+                ballSpin = BALL_SPIN * 0.25f;
+                break;
+            default:
+                ballSpin = 0.0f;
+                break;
+            }
 
-
-            ballVelocity = direction * speed;
+            velocityOf(ballEntity) = direction * speed;
+            BallState state;
+            state.x = ballPos.x;
+            state.y = ballPos.y;
+            state.vx = velocityOf(ballEntity).x;
+            state.vy = velocityOf(ballEntity).y;
+            SpinTable::launch(spinFlight, state, type, ballSpin, courtGeometry);
+            publishEvent(MatchEventType::SHOT_HIT, 1);
             hasBounced = false;
             canHit = false;
         }
     }
 
     void TennisScene::updateScoreDisplay() {
-        std::string p1Score, p2Score;
-
-        if (isDeuce) {
-            p1Score = p2Score = "40";
-        }
-        else if (player1Points >= 3 && player2Points >= 3) {
-            if (player1Points > player2Points) {
-                p1Score = "Ad";
-                p2Score = "40";
-            }
-            else if (player2Points > player1Points) {
-                p1Score = "40";
-                p2Score = "Ad";
-            }
-            else {
-                p1Score = p2Score = "40";
-            }
-        }
-        else {
-            p1Score = TENNIS_POINTS[std::min(player1Points, 4)];
-            p2Score = TENNIS_POINTS[std::min(player2Points, 4)];
-        }
+        scoreLabel->setString(score.getPointText());
+        gameScoreLabel->setString(score.getGameText());
+    }
 
-        std::string score = p1Score + " - " + p2Score;
-        std::string gameScore = std::to_string(player1Games) + "-" + std::to_string(player2Games) +
-            " (" + std::to_string(player1Sets) + "-" + std::to_string(player2Sets) + ")";
+    void TennisScene::publishEvent(MatchEventType type, int player) {
+        MatchEvent event;
+        event.type = type;
+        event.player = static_cast<uint8_t>(player);
+        event.deuceSide = score.isDeuceSide;
+        event.x = positionOf(ballEntity).x;
+        event.y = positionOf(ballEntity).y;
+        event.vx = velocityOf(ballEntity).x;
+        event.vy = velocityOf(ballEntity).y;
+        // El sonido sale ya, no cuando se vacie el bus al final del update;
+        // la latencia del mezclador se cuenta desde el inicio del paso.
+        AudioMixer::getInstance()->playEvent(event, courtGeometry.width, stepTime);
+        events.publish(event);
+    }
 
-        scoreLabel->setString(score);
-        gameScoreLabel->setString(gameScore);
+    void TennisScene::onScoreEvent(const MatchEvent& event) {
+        if (event.type == MatchEventType::POINT_WON) {
+            updateScoreDisplay();
+        }
     }
 
     void TennisScene::handlePointEnd(bool player1Won) {
         if (gameState == GameState::POINT_END) {
+            if (recorder.shouldAutoDump()) {
+                dumpFlightRecorder("handlePointEnd llamado de nuevo en POINT_END");
+            }
             return;
         }
 
@@ -476,63 +872,27 @@ namespace EpicGame {
         canServe = false;
         serveState = ServeState::READY;
 
-        if (player1Won) {
-            player1Points++;
-        }
-        else {
-            player2Points++;
-        }
+        int winner = player1Won ? 1 : 2;
+        int setsBefore = score.player1Sets + score.player2Sets;
+        bool gameWon = score.awardPoint(player1Won);
 
-        bool gameWon = false;
-
-        if (player1Points >= 3 && player2Points >= 3) {
-            if (player1Points == player2Points) {
-                isDeuce = true;
-            }
-            else if (player1Points > player2Points) {
-                if (player1Points - player2Points >= 2) {
-                    player1Games++;
-                    gameWon = true;
-                }
-            }
-            else {
-                if (player2Points - player1Points >= 2) {
-                    player2Games++;
-                    gameWon = true;
-                }
-            }
+        publishEvent(MatchEventType::POINT_WON, winner);
+        if (gameWon) {
+            publishEvent(MatchEventType::GAME_WON, winner);
         }
-        else {
-            if (player1Points >= 4 && player1Points - player2Points >= 2) {
-                player1Games++;
-                gameWon = true;
-            }
-            else if (player2Points >= 4 && player2Points - player1Points >= 2) {
-                player2Games++;
-                gameWon = true;
-            }
+        if (score.player1Sets + score.player2Sets != setsBefore) {
+            publishEvent(MatchEventType::SET_WON, winner);
         }
 
         if (gameWon) {
-            if (player1Games >= 6 && player1Games - player2Games >= 2) {
-                player1Sets++;
-                player1Games = player2Games = 0;
-            }
-            else if (player2Games >= 6 && player2Games - player2Games >= 2) {
-                player2Sets++;
-                player1Games = player2Games = 0;
-            }
-
-            player1Points = player2Points = 0;
-            isDeuce = false;
-            faultCount = 0;
             switchServer();
         }
         else {
             setupNextServe();
         }
 
-        ballVelocity = cocos2d::Vec2::ZERO;
+        velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
+        spinFlight = SpinFlight();
         hasBounced = false;
         hasBouncedInOpponentCourt = false;
 
@@ -542,25 +902,19 @@ namespace EpicGame {
         downPressed = false;
         spacePressed = false;
 
-        updateScoreDisplay();
         gameState = GameState::POINT_END;
+        sequences.cancelAll();
+        sequences.start(pointEndSequence());
     }
     void TennisScene::checkCourtBoundaries() {
-        auto visibleSize = Director::getInstance()->getVisibleSize();
-        Vec2 pos = ball->getPosition();
-        float perspectiveScale = getPerspectiveScale(pos.y);
-        float leftBoundary = (visibleSize.width - courtDims.width) / 2 +
-            (1.0f - perspectiveScale) * 20.0f;
-        float rightBoundary = (visibleSize.width + courtDims.width) / 2 -
-            (1.0f - perspectiveScale) * 20.0f;
-
-        bool isOut = pos.x < leftBoundary ||
-            pos.x > rightBoundary ||
-            pos.y < courtDims.baselineOffset ||
-            pos.y > visibleSize.height - courtDims.baselineOffset;
-
-        if (isOut) {
-            handlePointEnd(ballVelocity.y < 0);
+        BallState state;
+        state.x = positionOf(ballEntity).x;
+        state.y = positionOf(ballEntity).y;
+
+        // En el aire sobre las lineas todavia no esta fuera; lo decide el bote.
+        if (spinFlight.shot == ShotType::NORMAL && BallFlight::isOutOfCourt(state, courtGeometry)) {
+            publishEvent(MatchEventType::BOUNCE, state.y < courtGeometry.height * 0.5f ? 1 : 2);
+            handlePointEnd(velocityOf(ballEntity).y < 0);
         }
     }
 
@@ -581,6 +935,7 @@ namespace EpicGame {
         return false;
     }
     void TennisScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event) {
+        stepTime = AudioMixer::getTime();
         switch (keyCode) {
         case EventKeyboard::KeyCode::KEY_LEFT_ARROW:
             leftPressed = true;
@@ -597,23 +952,23 @@ namespace EpicGame {
         case EventKeyboard::KeyCode::KEY_SPACE:
             spacePressed = true;
             
-            if (isServing && servingPlayer == 1) {
+            if (isServing && score.servingPlayer == 1) {
                 if (serveState == ServeState::READY) {
                     serveState = ServeState::TOSS;
                     serveTimer = 0;
-                    ballVelocity = cocos2d::Vec2::ZERO;
+                    velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
                 }
                 else if (serveState == ServeState::READY_TO_HIT && canServe) {
                     hitServe();
                 }
             }
            
-            else if (servingPlayer == 2 || gameState == GameState::PLAY) {
-                cocos2d::Vec2 ballPos = ball->getPosition();
-                cocos2d::Vec2 playerPos = player1->getPosition();
+            else if (score.servingPlayer == 2 || gameState == GameState::PLAY) {
+                cocos2d::Vec2 ballPos = positionOf(ballEntity);
+                cocos2d::Vec2 playerPos = positionOf(player1Entity);
                 auto visibleSize = Director::getInstance()->getVisibleSize();
 
-                if (std::abs(ballPos.x - playerPos.x) < 100.0f &&
+                if (isBallReachable() && std::abs(ballPos.x - playerPos.x) < 100.0f &&
                     ballPos.y < visibleSize.height * 0.4f) {
 
                     cocos2d::Vec2 direction;
@@ -633,7 +988,9 @@ namespace EpicGame {
                     float speed = HIT_BASE_SPEED;
 
 
-                    ballVelocity = direction * speed;
+                    velocityOf(ballEntity) = direction * speed;
+                    spinFlight = SpinFlight();
+                    publishEvent(MatchEventType::SHOT_HIT, 1);
                     hasBounced = false;
                     hasBouncedInOpponentCourt = false;
                     ballInPlay = true;
@@ -645,6 +1002,25 @@ namespace EpicGame {
                 }
             }
             break;
+
+        case EventKeyboard::KeyCode::KEY_Z:
+            executeShot(ShotType::TOPSPIN);
+            break;
+        case EventKeyboard::KeyCode::KEY_X:
+            executeShot(ShotType::SLICE);
+            break;
+        case EventKeyboard::KeyCode::KEY_C:
+            executeShot(ShotType::LOB);
+            break;
+        case EventKeyboard::KeyCode::KEY_V:
+            executeShot(ShotType::SMASH);
+            break;
+        case EventKeyboard::KeyCode::KEY_F1:
+            dumpFlightRecorder("Volcado manual (F1)");
+            break;
+        case EventKeyboard::KeyCode::KEY_H:
+            toggleHeatmap();
+            break;
         }
     }
 
@@ -673,7 +1049,7 @@ namespace EpicGame {
     }
 
     void TennisScene::switchSides() {
-        isDeuceSide = true;
+        score.isDeuceSide = true;
         auto temp = player1LeftPos;
         player1LeftPos = player2LeftPos;
         player2LeftPos = temp;
@@ -685,51 +1061,55 @@ namespace EpicGame {
         updatePlayerPositions();
     }
 
-    void TennisScene::updateBallShadow() {
-        if (!ballShadow || !ball || !ballInPlay) {
-            if (ballShadow) {
-                ballShadow->setVisible(false);
-            }
-            return;
-        }
-
+    void TennisScene::updateShadows() {
         auto visibleSize = Director::getInstance()->getVisibleSize();
-        Vec2 ballPos = ball->getPosition();
         float courtBottom = visibleSize.height * 0.15f;
         float courtTop = visibleSize.height * 0.85f;
-        Vec2 shadowPos;
-        shadowPos.x = ballPos.x;
-        shadowPos.y = ballPos.y;  
 
-        float scale = BALL_BASE_SCALE;
-        if (shadowPos.y > visibleSize.height * 0.5f) {
-            
-            scale *= 0.6f;
-        }
-        else {
-            scale *= 0.8f;
-        }
-        shadowPos.y = std::min(std::max(shadowPos.y, courtBottom), courtTop);
+        for (int entity = 0; entity < world.size(); entity++) {
+            if (!world.has(entity, EntityStore::TRANSFORM | EntityStore::SHADOW_LINK) ||
+                world.shadowLinks[entity].shadow < 0) {
+                continue;
+            }
+
+            int shadow = world.shadowLinks[entity].shadow;
+            if (!ballInPlay) {
+                sprites.setVisible(shadow, false);
+                continue;
+            }
 
-        ballShadow->setPosition(shadowPos);
-        ballShadow->setScale(scale);
-        ballShadow->setOpacity(120);
-        ballShadow->setVisible(true);
-        ballShadow->setLocalZOrder(1);
+            Vec2 shadowPos = world.transforms[entity].position;
+
+            float scale = BALL_BASE_SCALE;
+            if (shadowPos.y > visibleSize.height * 0.5f) {
+                scale *= 0.6f;
+            }
+            else {
+                scale *= 0.8f;
+            }
+            shadowPos.y = std::min(std::max(shadowPos.y, courtBottom), courtTop);
+
+            world.transforms[shadow].position = shadowPos;
+            world.transforms[shadow].scale = scale;
+            sprites.setOpacity(shadow, 120);
+            sprites.setVisible(shadow, true);
+            sprites.setLocalZOrder(shadow, 1);
+        }
     }
 
     void TennisScene::resetBall() {
-        if (!ball || !player1) return;
+        if (ballEntity < 0 || player1Entity < 0) return;
 
-        ball->setPosition(player1->getPositionX(),
-            player1->getPositionY() + SERVE_START_HEIGHT);
-        ball->setScale(BALL_BASE_SCALE);
+        positionOf(ballEntity) = cocos2d::Vec2(positionOf(player1Entity).x,
+            positionOf(player1Entity).y + SERVE_START_HEIGHT);
+        world.transforms[ballEntity].scale = BALL_BASE_SCALE;
 
-        if (ballShadow) {
-            ballShadow->setVisible(false);
+        if (shadowEntity >= 0) {
+            sprites.setVisible(shadowEntity, false);
         }
 
-        ballVelocity = Vec2::ZERO;
+        velocityOf(ballEntity) = Vec2::ZERO;
+        spinFlight = SpinFlight();
         hasBounced = false; 
         hasBouncedInOpponentCourt = false;
         isServing = true;
@@ -746,43 +1126,7 @@ namespace EpicGame {
     }
     bool TennisScene::isInServiceBox(const cocos2d::Vec2& position) {
         auto visibleSize = Director::getInstance()->getVisibleSize();
-        float centerX = visibleSize.width * 0.5f;
-        float serviceBoxWidth = visibleSize.width * 0.2f;
-
-        if (servingPlayer == 1) {
-            float minY = visibleSize.height * 0.6f;  
-            float maxY = visibleSize.height * 0.85f; 
-
-            if (isDeuceSide) {
-                return (position.x >= centerX - serviceBoxWidth &&
-                    position.x <= centerX &&
-                    position.y >= minY &&
-                    position.y <= maxY);
-            }
-            else {
-                return (position.x >= centerX &&
-                    position.x <= centerX + serviceBoxWidth &&
-                    position.y >= minY &&
-                    position.y <= maxY);
-            }
-        }
-        else {
-            float minY = visibleSize.height * 0.15f; 
-            float maxY = visibleSize.height * 0.4f;  
-
-            if (isDeuceSide) {
-                return (position.x >= centerX &&
-                    position.x <= centerX + serviceBoxWidth &&
-                    position.y >= minY &&
-                    position.y <= maxY);
-            }
-            else {
-                return (position.x >= centerX - serviceBoxWidth &&
-                    position.x <= centerX &&
-                    position.y >= minY &&
-                    position.y <= maxY);
-            }
-        }
+        return score.isInServiceBox(position.x, position.y, visibleSize.width, visibleSize.height);
     }
     void TennisScene::hitBall() {
         if (!canHit) return;
@@ -791,12 +1135,12 @@ namespace EpicGame {
         float netY = visibleSize.height * 0.5f;
 
         cocos2d::Vec2 direction;
-        if (servingPlayer == 1) {
-            float minHeight = (netY - ball->getPositionY()) / visibleSize.height;
+        if (score.servingPlayer == 1) {
+            float minHeight = (netY - positionOf(ballEntity).y) / visibleSize.height;
             direction.y = std::max(2.0f, minHeight * 4.0f); 
         }
         else {
-            float minHeight = (ball->getPositionY() - netY) / visibleSize.height;
+            float minHeight = (positionOf(ballEntity).y - netY) / visibleSize.height;
             direction.y = std::min(-2.0f, -minHeight * 4.0f); 
         }
 
@@ -804,7 +1148,9 @@ namespace EpicGame {
         direction.normalize();
 
         float speed = HIT_SPEED * 1.3f;
-        ballVelocity = direction * speed;
+        velocityOf(ballEntity) = direction * speed;
+        spinFlight = SpinFlight();
+        publishEvent(MatchEventType::SHOT_HIT, 1);
 
         ballInPlay = true;
         hasBounced = false;
@@ -812,14 +1158,13 @@ namespace EpicGame {
     }
 
     void TennisScene::startNewPoint() {
-        faultCount = 0;
+        score.faultCount = 0;
         gameState = GameState::SERVE;
         isServing = true;
         ballInPlay = false;
         canHit = false;
         canServe = false;
-        currentShot = ShotType::NORMAL;
-        aiServeTimer = 0;
+        spinFlight = SpinFlight();
         serveState = ServeState::READY;
 
         leftPressed = false;
@@ -830,36 +1175,27 @@ namespace EpicGame {
 
         hasBounced = false;
         hasBouncedInOpponentCourt = false;
-        ballVelocity = cocos2d::Vec2::ZERO;
+        velocityOf(ballEntity) = cocos2d::Vec2::ZERO;
         positionPlayersForServe();
-        updateScoreDisplay();
     }
 
     void TennisScene::switchServer() {
-        servingPlayer = (servingPlayer == 1) ? 2 : 1;
-        if (servingPlayer == 2) {
-            isDeuceSide = false;  
-        }
-        else {
-            isDeuceSide = true;   
-        }
-
-        faultCount = 0;
+        score.switchServer();
         serveState = ServeState::READY;
         isServing = true;
-        aiServeTimer = 0;
 
         positionPlayersForServe();
     }
 
 
     void TennisScene::hitServe() {
+        sequences.cancelAll();
         auto visibleSize = Director::getInstance()->getVisibleSize();
         float centerX = visibleSize.width * 0.5f;
         float targetX;
 
-        if (servingPlayer == 2) {
-            if (isDeuceSide) {
+        if (score.servingPlayer == 2) {
+            if (score.isDeuceSide) {
                 targetX = centerX - (visibleSize.width * 0.25f);
             }
             else {
@@ -868,13 +1204,13 @@ namespace EpicGame {
 
             cocos2d::Vec2 direction;
             direction.y = -2.0f;
-            direction.x = (targetX - ball->getPositionX()) / (visibleSize.width * 0.3f);
+            direction.x = (targetX - positionOf(ballEntity).x) / (visibleSize.width * 0.3f);
             direction.normalize();
-            ballVelocity = direction * 600.0f;
+            velocityOf(ballEntity) = direction * 600.0f;
             canHit = true;
         }
         else {
-            if (isDeuceSide) {
+            if (score.isDeuceSide) {
                 targetX = centerX - (visibleSize.width * 0.15f);
             }
             else {
@@ -883,13 +1219,14 @@ namespace EpicGame {
 
             cocos2d::Vec2 direction;
             direction.y = 2.0f;
-            direction.x = (targetX - ball->getPositionX()) / (visibleSize.width * 0.3f);
+            direction.x = (targetX - positionOf(ballEntity).x) / (visibleSize.width * 0.3f);
             direction.normalize();
-            ballVelocity = direction * 700.0f;
+            velocityOf(ballEntity) = direction * 700.0f;
         }
 
-        ball->setVisible(true);
-        ballShadow->setVisible(true);
+        publishEvent(MatchEventType::SERVE, score.servingPlayer);
+        sprites.setVisible(ballEntity, true);
+        sprites.setVisible(shadowEntity, true);
         isServing = false;
         ballInPlay = true;
         serveState = ServeState::READY;
@@ -899,7 +1236,7 @@ namespace EpicGame {
 
 
     void TennisScene::setupNextServe() {
-        isDeuceSide = !isDeuceSide;
+        score.alternateServiceSide();
         startNewPoint();
     }
 
@@ -910,27 +1247,28 @@ namespace EpicGame {
         float backBaselineY = visibleSize.height * 0.92f;
         float centerOffset = visibleSize.width * 0.05f;
 
-        if (servingPlayer == 2) { 
-            if (isDeuceSide) {
-                player2->setPosition(centerX + centerOffset, backBaselineY);
-                player1->setPosition(centerX - centerOffset, frontBaselineY);
+        if (score.servingPlayer == 2) { 
+            if (score.isDeuceSide) {
+                positionOf(player2Entity) = cocos2d::Vec2(centerX + centerOffset, backBaselineY);
+                positionOf(player1Entity) = cocos2d::Vec2(centerX - centerOffset, frontBaselineY);
             }
             else {
-                player2->setPosition(centerX - centerOffset, backBaselineY);
-                player1->setPosition(centerX + centerOffset, frontBaselineY);
+                positionOf(player2Entity) = cocos2d::Vec2(centerX - centerOffset, backBaselineY);
+                positionOf(player1Entity) = cocos2d::Vec2(centerX + centerOffset, frontBaselineY);
             }
-            ball->setPosition(player2->getPositionX(), player2->getPositionY());
+            positionOf(ballEntity) = positionOf(player2Entity);
         }
         else { 
-            if (isDeuceSide) {
-                player1->setPosition(centerX + centerOffset, frontBaselineY);
-                player2->setPosition(centerX - (visibleSize.width * 0.2f), backBaselineY);
+            if (score.isDeuceSide) {
+                positionOf(player1Entity) = cocos2d::Vec2(centerX + centerOffset, frontBaselineY);
+                positionOf(player2Entity) = cocos2d::Vec2(centerX - (visibleSize.width * 0.2f), backBaselineY);
             }
             else {
-                player1->setPosition(centerX - centerOffset, frontBaselineY);
-                player2->setPosition(centerX + (visibleSize.width * 0.2f), backBaselineY);
+                positionOf(player1Entity) = cocos2d::Vec2(centerX - centerOffset, frontBaselineY);
+                positionOf(player2Entity) = cocos2d::Vec2(centerX + (visibleSize.width * 0.2f), backBaselineY);
             }
-            ball->setPosition(player1->getPositionX(), player1->getPositionY() + SERVE_START_HEIGHT);
+            positionOf(ballEntity) = cocos2d::Vec2(positionOf(player1Entity).x,
+                positionOf(player1Entity).y + SERVE_START_HEIGHT);
         }
     }
 
@@ -941,9 +1279,10 @@ namespace EpicGame {
     void TennisScene::resetServe() {
         serveState = ServeState::READY;
         serveTimer = 0;
-        ball->setPosition(player1->getPositionX(), player1->getPositionY() + SERVE_START_HEIGHT);
-        ball->setScale(BALL_BASE_SCALE);
-        ballShadow->setVisible(false);
+        positionOf(ballEntity) = cocos2d::Vec2(positionOf(player1Entity).x,
+            positionOf(player1Entity).y + SERVE_START_HEIGHT);
+        world.transforms[ballEntity].scale = BALL_BASE_SCALE;
+        sprites.setVisible(shadowEntity, false);
         canServe = false;
 
     }
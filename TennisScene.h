@@ -2,6 +2,23 @@
 #define __TENNIS_SCENE_H__
 
 #include "cocos2d.h"
+#include "BallFlight.h"
+#include "BounceHeatmap.h"
+#include "CourtDrawing.h"
+#include "CrowdLayer.h"
+#include "EntityStore.h"
+#include "FlightRecorder.h"
+#include "FrameEncoder.h"
+#include "InputLatencyHarness.h"
+#include "MatchEvents.h"
+#include "MatchReplay.h"
+#include "MatchStepper.h"
+#include "Sequence.h"
+#include "SpinTable.h"
+#include "SpriteProxy.h"
+#include "StateHash.h"
+#include "TennisRules.h"
+#include <memory>
 #include <vector>
 #include <random>
 
@@ -10,6 +27,13 @@ namespace EpicGame {
     class TennisScene : public cocos2d::Scene {
     public:
         static cocos2d::Scene* createScene();
+        // Reproduce una MatchReplay con los sprites de la escena, sin teclado,
+        // y escribe cada frame (60 fps) en outputDir lo mas rapido posible.
+        static cocos2d::Scene* createReplayExport(const std::string& replayPath, const std::string& outputDir,
+            FrameEncoder::Format format);
+        // Partida normal en la que InputLatencyHarness pulsa SPACE trials
+        // veces con la pelota a tiro y guarda las latencias en outputPrefix_*.csv.
+        static cocos2d::Scene* createInputLatencyTest(int trials, const std::string& outputPrefix, int stressRate);
         virtual bool init();
         CREATE_FUNC(TennisScene);
 
@@ -17,6 +41,8 @@ namespace EpicGame {
         const float SERVE_HEIGHT = 100.0f;
         const float SERVE_START_HEIGHT = 30.0f;
         const float SERVE_DURATION = 0.8f;
+        const float AI_SERVE_DELAY = 1.0f;
+        const float POINT_END_DELAY = 0.5f;
         const float SERVE_SPEED = 700.0f;
         const float HIT_BASE_SPEED = 500.0f;
         const float HIT_SPEED = 750.0f;
@@ -40,6 +66,29 @@ namespace EpicGame {
         bool hasBouncedInOpponentCourt = false;
         const float NET_Y = 0.5f;
         const float COURT_TOP = 0.85f;
+        const int CROWD_SIZE = 8000;
+        const int RECORDER_FRAMES = 1024;   // unos 17 s a 60 fps
+        const float EXPORT_FRAME_TIME = 1.0f / 60.0f;
+        const double EXPORT_TICK_BUDGET = 0.012;  // s de render por tick
+
+        struct ReplayExport {
+            MatchReplay replay;
+            MatchSim sim;
+            std::unique_ptr<MatchStepper<ReplayPlaybackPolicy, ReplayPlaybackPolicy>> stepper;
+            std::unique_ptr<FrameEncoder> encoder;
+            cocos2d::RenderTexture* target = nullptr;
+            size_t frame = 0;
+            double replayTime = 0.0;
+            double videoTime = 0.0;
+            uint32_t videoFrame = 0;
+            double startTime = 0.0;
+
+            ~ReplayExport() {
+                if (target) {
+                    target->release();
+                }
+            }
+        };
 
         struct CourtDimensions {
             float width;
@@ -65,53 +114,51 @@ namespace EpicGame {
             GAME_END
         };
 
-        enum class ShotType {
-            NORMAL,
-            TOPSPIN,
-            SLICE,
-            LOB,
-            SMASH
-        };
-
-        cocos2d::Sprite* court = nullptr;
-        cocos2d::Sprite* player1 = nullptr;
-        cocos2d::Sprite* player2 = nullptr;
-        cocos2d::Sprite* ball = nullptr;
-        cocos2d::Sprite* ballShadow = nullptr;
+        cocos2d::DrawNode* court = nullptr;
+        cocos2d::Sprite* heatmapOverlay = nullptr;
+        CrowdLayer* crowd = nullptr;
+        BounceHeatmap bounceHeatmap;
+        bool heatmapDirty = false;
+        EntityStore world;
+        SpriteProxy sprites;              // mismo indice que las entidades
+        int player1Entity = -1;
+        int player2Entity = -1;
+        int ballEntity = -1;
+        int shadowEntity = -1;
         cocos2d::Label* scoreLabel = nullptr;
         cocos2d::Label* gameScoreLabel = nullptr;
         cocos2d::Label* serviceIndicator = nullptr;
 
         CourtDimensions courtDims;
+        CourtGeometry courtGeometry;
         GameState gameState = GameState::SERVE;
         ServeState serveState = ServeState::READY;
-        ShotType currentShot = ShotType::NORMAL;
+        SpinFlight spinFlight;            // golpe con efecto de la pelota, hasta que bota
+        MatchScore score;
+        MatchEventBus events;
+        SequenceScheduler sequences;
+        FlightRecorder recorder{ static_cast<size_t>(RECORDER_FRAMES) };
+        uint32_t frameIndex = 0;
+        double stepTime = 0.0;            // AudioMixer::getTime() al empezar el update o la tecla
+        std::unique_ptr<ReplayExport> replayExport;
+        std::unique_ptr<InputLatencyHarness> latencyTest;
+        uint32_t aiSeed = 0;
+        std::minstd_rand aiRng;
 
-        bool isDeuce = false;
         bool isMatchPoint = false;
         int currentSet = 1;
-        bool isDeuceSide = true;
         int pointsToWinGame = 4;
         int serverPosition = 1;
-        int player1Points = 0;
-        int player2Points = 0;
-        int player1Games = 0;
-        int player2Games = 0;
-        int player1Sets = 0;
-        int player2Sets = 0;
 
         bool isServing = true;
         bool ballInPlay = false;
-        int servingPlayer = 1;
         float serveTimer = 0.0f;
         bool isPowerCharging = false;
         float powerCharge = 0.0f;
         float shotAngle = 0.0f;
-        int faultCount = 0;
         bool lastPointWinner = true;
         int playerScore = 0;
         int aiScore = 0;
-        float aiServeTimer = 0.0f;
 
         bool leftPressed = false;
         bool rightPressed = false;
@@ -121,7 +168,6 @@ namespace EpicGame {
         bool canHit = false;
         bool canServe = false;
 
-        cocos2d::Vec2 ballVelocity;
         cocos2d::Vec2 lastHitDirection;
         float ballSpin = 0.0f;
         cocos2d::Vec2 player1LeftPos;
@@ -129,22 +175,41 @@ namespace EpicGame {
         cocos2d::Vec2 player2LeftPos;
         cocos2d::Vec2 player2RightPos;
 
-        const std::vector<std::string> TENNIS_POINTS{ "0", "15", "30", "40", "Ad" };
-
         void initCourt();
         void initPlayers();
         void initBall();
         void initUI();
         void initShadows();
+        void toggleHeatmap();
+        void updateHeatmapTexture();
+
+        int addEntity(cocos2d::Sprite* sprite, uint8_t components, int zOrder);
+        cocos2d::Vec2& positionOf(int entity) { return world.transforms[entity].position; }
+        cocos2d::Vec2& velocityOf(int entity) { return world.velocities[entity].value; }
+        cocos2d::Sprite* spriteOf(int entity) { return sprites.getSprite(entity); }
+        // Un globo por encima de REACH_HEIGHT pasa por encima de quien este.
+        bool isBallReachable() const {
+            return spinFlight.shot == ShotType::NORMAL || spinFlight.height <= SpinTable::REACH_HEIGHT;
+        }
 
         void update(float delta) override;
-        void updatePlayerPosition(float delta);
-        void updateBallPhysics(float delta);
-        void updateServe(float delta);
-        void updateAI(float delta);
+        void updateKeyboardControllers(float delta);
+        void updateBalls(float delta);
+        void updateAIControllers(float delta);
+        float findOpponentX(int team);
         void updatePowerCharge(float delta);
-        void updateBallShadow();
+        void updateShadows();
+        void syncSprites();
+        void recordFrame(float delta);
+        void updateFramePacing();
+        void updateReplayExport();
+        void applyReplayState(const MatchSim::State& state, const CourtGeometryT<Scalar>& simCourt);
+        void captureExportFrame();
+        void dumpFlightRecorder(const std::string& reason);
+        void prepareLatencyTrial();
         void updateScoreDisplay();
+        void publishEvent(MatchEventType type, int player);
+        void onScoreEvent(const MatchEvent& event);
         void updatePlayerPositions();
 
         void hitBall();
@@ -155,6 +220,11 @@ namespace EpicGame {
         void checkCourtBoundaries();
         bool isInServiceBox();
 
+        Sequence playerServeSequence();
+        Sequence aiServeSequence();
+        Sequence pointEndSequence();
+        void startServeSequence();
+
         void handlePointEnd(bool player1Won);
         void startNewPoint();
         void switchServer();
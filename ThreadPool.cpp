@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace EpicGame {
+
+    ThreadPool::ThreadPool(int threadCount) {
+        for (int i = 1; i < threadCount; i++) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run(int count, int grainSize, RangeFunc func, void* context) {
+        if (count <= 0) {
+            return;
+        }
+
+        grainSize = std::max(grainSize, 1);
+        if (workers.empty() || count <= grainSize) {
+            func(context, 0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            currentFunc = func;
+            currentContext = context;
+            currentCount = count;
+            currentGrain = grainSize;
+            nextIndex.store(0, std::memory_order_relaxed);
+            busyWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        wakeCondition.notify_all();
+
+        drain();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+    }
+
+    void ThreadPool::drain() {
+        for (;;) {
+            int begin = nextIndex.fetch_add(currentGrain, std::memory_order_relaxed);
+            if (begin >= currentCount) {
+                return;
+            }
+            currentFunc(currentContext, begin, std::min(begin + currentGrain, currentCount));
+        }
+    }
+
+    void ThreadPool::workerLoop() {
+        uint64_t seenGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) {
+                    return;
+                }
+                seenGeneration = generation;
+            }
+
+            drain();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) {
+                doneCondition.notify_one();
+            }
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EpicGame {
+
+    // Pool de hilos persistente para repartir rangos de indices. parallelFor
+    // no reserva memoria: el trabajo se pasa como puntero a funcion + contexto.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(int threadCount);
+        ~ThreadPool();
+
+        int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+        // Ejecuta func(begin, end) sobre [0, count) en bloques de grainSize.
+        // El hilo llamador tambien trabaja y la llamada vuelve al terminar todo.
+        template <typename Func>
+        void parallelFor(int count, int grainSize, Func& func) {
+            run(count, grainSize, &ThreadPool::invoke<Func>, &func);
+        }
+
+    private:
+        typedef void (*RangeFunc)(void* context, int begin, int end);
+
+        template <typename Func>
+        static void invoke(void* context, int begin, int end) {
+            (*static_cast<Func*>(context))(begin, end);
+        }
+
+        void run(int count, int grainSize, RangeFunc func, void* context);
+        void workerLoop();
+        void drain();
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable doneCondition;
+        uint64_t generation = 0;
+        int busyWorkers = 0;
+        bool stopping = false;
+
+        RangeFunc currentFunc = nullptr;
+        void* currentContext = nullptr;
+        int currentCount = 0;
+        int currentGrain = 1;
+        std::atomic<int> nextIndex{ 0 };
+    };
+
+}
+
+#endif
\ No newline at end of file
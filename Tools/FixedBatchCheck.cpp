@@ -0,0 +1,92 @@
+// Comprueba que BallFlight::integrateBatch (Q16.16, SSE4.1 si esta disponible)
+// da exactamente lo mismo que integrate<Fixed> pelota a pelota, y compara su
+// rendimiento con integrate<float>.
+//
+//   g++ -std=c++17 -O2 -msse4.1 -I.. FixedBatchCheck.cpp ../BallFlight.cpp -o FixedBatchCheck
+//   ./FixedBatchCheck [pelotas] [pasos]
+
+#include "../BallFlight.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace EpicGame;
+
+int main(int argc, char* argv[])
+{
+    int ballCount = argc > 1 ? atoi(argv[1]) : 4099;
+    int stepCount = argc > 2 ? atoi(argv[2]) : 600;
+    const float delta = 1.0f / 60.0f;
+
+    std::minstd_rand rng(1);
+    std::uniform_real_distribution<float> position(100.0f, 1100.0f);
+    std::uniform_real_distribution<float> velocity(-700.0f, 700.0f);
+
+    std::vector<int32_t> x(ballCount), y(ballCount), vx(ballCount), vy(ballCount);
+    std::vector<uint8_t> alive(ballCount);
+    std::vector<BallStateT<Fixed>> reference(ballCount);
+    std::vector<BallStateT<float>> floats(ballCount);
+
+    for (int i = 0; i < ballCount; i++) {
+        BallStateT<Fixed>& ball = reference[i];
+        ball.x = position(rng);
+        ball.y = position(rng);
+        ball.vx = velocity(rng);
+        ball.vy = velocity(rng);
+        alive[i] = i % 7 != 3;
+        x[i] = ball.x.raw;
+        y[i] = ball.y.raw;
+        vx[i] = ball.vx.raw;
+        vy[i] = ball.vy.raw;
+        floats[i].x = toFloat(ball.x);
+        floats[i].y = toFloat(ball.y);
+        floats[i].vx = toFloat(ball.vx);
+        floats[i].vy = toFloat(ball.vy);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < stepCount; s++) {
+        BallFlight::integrateBatch(x.data(), y.data(), vx.data(), vy.data(), alive.data(), ballCount, Fixed(delta));
+    }
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int s = 0; s < stepCount; s++) {
+        for (int i = 0; i < ballCount; i++) {
+            if (alive[i]) {
+                BallFlight::integrate(floats[i], delta);
+            }
+        }
+    }
+    double floatSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int s = 0; s < stepCount; s++) {
+        for (int i = 0; i < ballCount; i++) {
+            if (alive[i]) {
+                BallFlight::integrate(reference[i], Fixed(delta));
+            }
+        }
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < ballCount; i++) {
+        const BallStateT<Fixed>& ball = reference[i];
+        if (ball.x.raw != x[i] || ball.y.raw != y[i] || ball.vx.raw != vx[i] || ball.vy.raw != vy[i]) {
+            if (mismatches++ == 0) {
+                fprintf(stderr, "Error: la pelota %d no coincide con integrate<Fixed>\n", i);
+            }
+        }
+    }
+
+    double updates = static_cast<double>(ballCount) * stepCount;
+#if defined(__SSE4_1__)
+    const char* kernel = "SSE4.1";
+#else
+    const char* kernel = "escalar";
+#endif
+    printf("%d pelotas x %d pasos: lote Q16.16 (%s) %.2f ns/pelota, float %.2f ns/pelota, %d diferencias\n",
+        ballCount, stepCount, kernel, batchSeconds * 1e9 / updates, floatSeconds * 1e9 / updates, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
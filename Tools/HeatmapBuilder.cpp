@@ -0,0 +1,133 @@
+// Simula partidos IA contra IA con MatchSim en varios hilos y acumula donde
+// muere la pelota en un BounceHeatmap (Resources/bounce_heatmap.bin), que la
+// escena pinta encima de la pista con la tecla H. Cada hilo llena su propio
+// histograma y al final se suman en paralelo.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. HeatmapBuilder.cpp ../BallFlight.cpp ../TennisRules.cpp ../ShotTable.cpp ../MappedFile.cpp
+//       ../MatchSim.cpp ../MatchEvents.cpp ../BounceHeatmap.cpp ../ThreadPool.cpp ../SpinTable.cpp -o HeatmapBuilder
+//   ./HeatmapBuilder 20000 8 ../Resources/bounce_heatmap.bin
+
+#include "../BounceHeatmap.h"
+#include "../MatchSim.h"
+#include "../MatchStepper.h"
+#include "../ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    const float STEP = 1.0f / 60.0f;
+    // Una hora de juego como maximo por partido.
+    const uint64_t MAX_MATCH_STEPS = 60ull * 60ull * 60ull;
+    const int DISPATCH_INTERVAL = 64;
+
+    struct Worker {
+        MatchSim sim;
+        MatchEventBus bus;
+        BounceHeatmap heatmap;
+        uint64_t steps = 0;
+        uint64_t points = 0;
+    };
+
+    // Un partido es un set; termina antes si llega a MAX_MATCH_STEPS.
+    void playMatch(Worker& worker, uint64_t seed) {
+        MatchSim& sim = worker.sim;
+        sim.reset(seed);
+        sim.setEventBus(&worker.bus);
+
+        MatchStepper<ScriptedAIPolicy, ScriptedAIPolicy> stepper(sim);
+        int setsBefore = 0;
+        for (uint64_t step = 1; step <= MAX_MATCH_STEPS; step++) {
+            MatchSim::StepResult result = stepper.step(STEP);
+            worker.steps++;
+            if (step % DISPATCH_INTERVAL == 0) {
+                worker.bus.dispatch();
+            }
+
+            if (result.pointEnded) {
+                worker.points++;
+                const MatchScore& score = sim.getState().score;
+                if (result.gameWon && score.player1Sets + score.player2Sets != setsBefore) {
+                    break;
+                }
+            }
+        }
+        worker.bus.dispatch();
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    int matchCount = argc > 1 ? atoi(argv[1]) : 1000;
+    int threadCount = argc > 2 ? atoi(argv[2]) : 4;
+    std::string outputPath = argc > 3 ? argv[3] : "bounce_heatmap.bin";
+
+    if (matchCount <= 0 || threadCount <= 0) {
+        fprintf(stderr, "Uso: %s partidos hilos salida.bin\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(new Worker());
+        Worker* worker = workers.back().get();
+        const CourtGeometryT<Scalar>& court = worker->sim.getCourt();
+        float width = toFloat(court.width);
+        float height = toFloat(court.height);
+        worker->bus.subscribe([worker, width, height](const MatchEvent& event) {
+            if (event.type == MatchEventType::BOUNCE) {
+                worker->heatmap.add(event.x / width, event.y / height);
+            }
+        });
+    }
+
+    ThreadPool pool(threadCount);
+    auto start = std::chrono::steady_clock::now();
+
+    // Cada hilo se queda con los partidos i, i + hilos, i + 2 * hilos...
+    auto body = [&](int begin, int end) {
+        for (int w = begin; w < end; w++) {
+            for (int match = w; match < matchCount; match += threadCount) {
+                playMatch(*workers[w], static_cast<uint64_t>(match) + 1);
+            }
+        }
+    };
+    pool.parallelFor(threadCount, 1, body);
+
+    auto simulated = std::chrono::steady_clock::now();
+
+    std::vector<const BounceHeatmap*> parts;
+    uint64_t totalSteps = 0;
+    uint64_t totalPoints = 0;
+    for (auto& worker : workers) {
+        parts.push_back(&worker->heatmap);
+        totalSteps += worker->steps;
+        totalPoints += worker->points;
+    }
+    BounceHeatmap heatmap;
+    BounceHeatmap::reduce(parts, heatmap, &pool);
+
+    auto reduced = std::chrono::steady_clock::now();
+
+    if (!heatmap.save(outputPath)) {
+        fprintf(stderr, "Error: No se pudo escribir %s\n", outputPath.c_str());
+        return 1;
+    }
+
+    double simSeconds = std::chrono::duration<double>(simulated - start).count();
+    double reduceMs = std::chrono::duration<double, std::milli>(reduced - simulated).count();
+    printf("%d partidos, %llu puntos, %llu botes, %llu pasos en %.2f s (%.1f M pasos/s), suma en %.3f ms\n",
+        matchCount, static_cast<unsigned long long>(totalPoints),
+        static_cast<unsigned long long>(heatmap.getTotal()), static_cast<unsigned long long>(totalSteps),
+        simSeconds, totalSteps / simSeconds / 1e6, reduceMs);
+    printf("%s: %dx%d celdas, maximo %u\n", outputPath.c_str(), BounceHeatmap::BINS_X, BounceHeatmap::BINS_Y,
+        heatmap.getMaxCount());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+// Simula partidos IA contra IA con MatchSim en varios hilos y vuelca las
+// estadisticas de cada partido (MatchStats) en CSV o en binario por columnas.
+//
+//   g++ -std=c++20 -O2 -pthread -I.. MatchStatsRunner.cpp ../BallFlight.cpp ../TennisRules.cpp ../ShotTable.cpp ../MappedFile.cpp
+//       ../MatchSim.cpp ../MatchEvents.cpp ../MatchStats.cpp ../ThreadPool.cpp ../SpinTable.cpp -o MatchStatsRunner
+//   ./MatchStatsRunner 10000 8 stats.csv
+//   ./MatchStatsRunner 10000 8 stats.bin
+//   ./MatchStatsRunner 10000 8 --no-stats     (misma simulacion sin estadisticas)
+//   ./MatchStatsRunner 10000 8 --overhead     (cada partido sin y con estadisticas; coste en %)
+
+#include "../MatchSim.h"
+#include "../MatchStepper.h"
+#include "../MatchStats.h"
+#include "../ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    const float STEP = 1.0f / 60.0f;
+    // Una hora de juego como maximo por partido.
+    const uint64_t MAX_MATCH_STEPS = 60ull * 60ull * 60ull;
+    const size_t BATCH_ROWS = 4096;
+    // Hay un golpe cada decenas de pasos, asi que en 512 pasos entran unos
+    // pocos eventos, muy lejos de los 1024 que caben en la cola del bus.
+    const int DISPATCH_INTERVAL = 512;
+
+    struct Worker {
+        MatchSim sim;
+        MatchEventBus bus;
+        MatchStatsAccumulator stats;
+        MatchStatsTable table{ BATCH_ROWS };
+        uint64_t steps = 0;
+    };
+
+    // Un partido es un set; termina antes si llega a MAX_MATCH_STEPS.
+    uint64_t playMatch(Worker& worker, uint64_t seed, bool collect, int& winner) {
+        MatchSim& sim = worker.sim;
+        sim.reset(seed);
+        sim.setEventBus(collect ? &worker.bus : nullptr);
+        worker.stats.reset();
+
+        MatchStepper<ScriptedAIPolicy, ScriptedAIPolicy> stepper(sim);
+        uint64_t step = 0;
+        int setsBefore = 0;
+        winner = 0;
+        while (step < MAX_MATCH_STEPS) {
+            MatchSim::StepResult result = stepper.step(STEP);
+            step++;
+
+            if (collect && step % DISPATCH_INTERVAL == 0) {
+                worker.bus.dispatch();
+            }
+
+            const MatchScore& score = sim.getState().score;
+            if (result.gameWon && score.player1Sets + score.player2Sets != setsBefore) {
+                winner = result.player1Won ? 1 : 2;
+                break;
+            }
+        }
+
+        if (collect) {
+            worker.bus.dispatch();
+        }
+        return step;
+    }
+
+    // Juega los partidos repartidos entre los hilos y devuelve los segundos.
+    // Sin escritor abierto las filas se acumulan igual pero no se guardan.
+    double runMatches(std::vector<std::unique_ptr<Worker>>& workers, ThreadPool& pool, int matchCount,
+                      bool collect, MatchStatsWriter& writer) {
+        int threadCount = static_cast<int>(workers.size());
+        for (auto& worker : workers) {
+            worker->steps = 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Cada hilo se queda con los partidos i, i + hilos, i + 2 * hilos...
+        auto body = [&](int begin, int end) {
+            for (int w = begin; w < end; w++) {
+                Worker& worker = *workers[w];
+                for (int match = w; match < matchCount; match += threadCount) {
+                    int winner = 0;
+                    uint64_t seed = static_cast<uint64_t>(match) + 1;
+                    uint64_t steps = playMatch(worker, seed, collect, winner);
+                    worker.steps += steps;
+
+                    if (collect) {
+                        worker.table.append(seed, steps, winner, worker.stats.getStats());
+                        if (worker.table.rows() >= BATCH_ROWS) {
+                            writer.writeBatch(worker.table);
+                            worker.table.clear();
+                        }
+                    }
+                }
+                if (collect) {
+                    writer.writeBatch(worker.table);
+                    worker.table.clear();
+                }
+            }
+        };
+        pool.parallelFor(threadCount, 1, body);
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64_t totalSteps(const std::vector<std::unique_ptr<Worker>>& workers) {
+        uint64_t steps = 0;
+        for (auto& worker : workers) {
+            steps += worker->steps;
+        }
+        return steps;
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    int matchCount = argc > 1 ? atoi(argv[1]) : 1000;
+    int threadCount = argc > 2 ? atoi(argv[2]) : 4;
+    std::string outputPath = argc > 3 ? argv[3] : "match_stats.csv";
+    bool overhead = outputPath == "--overhead";
+    bool collect = outputPath != "--no-stats";
+
+    if (matchCount <= 0 || threadCount <= 0) {
+        fprintf(stderr, "Uso: %s partidos hilos salida.csv|salida.bin|--no-stats|--overhead\n", argv[0]);
+        return 1;
+    }
+
+    MatchStatsWriter writer;
+    if (collect && !overhead) {
+        bool binary = outputPath.size() > 4 && outputPath.compare(outputPath.size() - 4, 4, ".bin") == 0;
+        if (!writer.open(outputPath, binary ? MatchStatsWriter::Format::BINARY : MatchStatsWriter::Format::CSV)) {
+            fprintf(stderr, "Error: No se pudo abrir %s\n", outputPath.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(new Worker());
+        Worker* worker = workers.back().get();
+        worker->bus.subscribe([worker](const MatchEvent& event) { worker->stats.onEvent(event); });
+    }
+
+    ThreadPool pool(threadCount);
+
+    if (overhead) {
+        // Cada partido se juega dos veces seguidas, sin y con estadisticas,
+        // alternando el orden. Asi las variaciones de frecuencia o de carga
+        // de la maquina caen igual en las dos mitades.
+        std::vector<double> plainSeconds(threadCount, 0.0);
+        std::vector<double> statsSeconds(threadCount, 0.0);
+        auto body = [&](int begin, int end) {
+            for (int w = begin; w < end; w++) {
+                Worker& worker = *workers[w];
+                for (int match = w; match < matchCount; match += threadCount) {
+                    uint64_t seed = static_cast<uint64_t>(match) + 1;
+                    for (int pass = 0; pass < 2; pass++) {
+                        bool withStats = (pass == 0) == (match % 2 == 0);
+                        int winner = 0;
+                        auto start = std::chrono::steady_clock::now();
+                        uint64_t steps = playMatch(worker, seed, withStats, winner);
+                        if (withStats) {
+                            worker.table.append(seed, steps, winner, worker.stats.getStats());
+                            worker.table.clear();
+                        }
+                        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                        (withStats ? statsSeconds : plainSeconds)[w] += seconds;
+                        worker.steps += withStats ? steps : 0;
+                    }
+                }
+            }
+        };
+        pool.parallelFor(threadCount, 1, body);
+
+        double plain = 0.0;
+        double measured = 0.0;
+        for (int w = 0; w < threadCount; w++) {
+            plain += plainSeconds[w];
+            measured += statsSeconds[w];
+        }
+        double percent = (measured - plain) / plain * 100.0;
+        printf("%d partidos, %llu pasos: sin estadisticas %.3f s, con estadisticas %.3f s, coste %+.2f%%%s\n",
+            matchCount, static_cast<unsigned long long>(totalSteps(workers)), plain, measured, percent,
+            percent < 2.0 ? "" : " (por encima del 2%)");
+        return percent < 2.0 ? 0 : 2;
+    }
+
+    double seconds = runMatches(workers, pool, matchCount, collect, writer);
+    uint64_t steps = totalSteps(workers);
+
+    printf("%d partidos, %llu pasos en %.2f s (%.1f M pasos/s)%s\n", matchCount,
+        static_cast<unsigned long long>(steps), seconds, steps / seconds / 1e6,
+        collect ? "" : ", sin estadisticas");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+// Pasa partidos reales punto a punto (CSV de tennis_pointbypoint, columnas
+// "pbp" y "winner") por las reglas de MatchScore. Dice cuantos juegos, sets
+// y partidos no cierran igual que en la realidad y saca los porcentajes de
+// saque y resto para calibrar la IA.
+//
+//   g++ -std=c++20 -O2 -I.. PointByPointCheck.cpp ../PointByPoint.cpp ../MappedFile.cpp ../TennisRules.cpp
+//       -o PointByPointCheck
+//   ./PointByPointCheck pbp_matches_atp_main_current.csv [mas.csv...]
+
+#include "../PointByPoint.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace EpicGame;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s partidos.csv [mas.csv...]\n", argv[0]);
+        return 1;
+    }
+
+    PointByPointStats total;
+    double seconds = 0.0;
+    for (int i = 1; i < argc; i++) {
+        PointByPointReader reader;
+        if (!reader.open(argv[i])) {
+            fprintf(stderr, "Error: No se pudo abrir %s (o no tiene columna pbp)\n", argv[i]);
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        PointByPointStats stats = reader.run();
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%s: %llu partidos, %llu puntos\n", argv[i], static_cast<unsigned long long>(stats.matches),
+            static_cast<unsigned long long>(stats.points));
+        total.merge(stats);
+    }
+
+    printf("%llu partidos (%llu filas sin pbp), %llu sets, %llu juegos (%llu tie-breaks), %llu puntos en %.3f s (%.1f M puntos/s)\n",
+        static_cast<unsigned long long>(total.matches), static_cast<unsigned long long>(total.skippedRows),
+        static_cast<unsigned long long>(total.sets), static_cast<unsigned long long>(total.games),
+        static_cast<unsigned long long>(total.tiebreaks), static_cast<unsigned long long>(total.points),
+        seconds, seconds > 0.0 ? total.points / seconds / 1e6 : 0.0);
+    printf("Saque: %.1f%% puntos, %.1f%% juegos; resto: %.1f%% puntos; aces %.1f%%, dobles faltas %.1f%%\n",
+        100.0 * total.getServeWinRate(), 100.0 * total.getHoldRate(), 100.0 * total.getReturnWinRate(),
+        total.points ? 100.0 * total.aces / total.points : 0.0,
+        total.points ? 100.0 * total.doubleFaults / total.points : 0.0);
+    printf("No cuadran con MatchScore: %llu juegos, %llu sets, %llu partidos\n",
+        static_cast<unsigned long long>(total.gameMismatches), static_cast<unsigned long long>(total.setMismatches),
+        static_cast<unsigned long long>(total.matchMismatches));
+    return total.gameMismatches || total.setMismatches || total.matchMismatches ? 2 : 0;
+}
\ No newline at end of file
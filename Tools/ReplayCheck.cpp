@@ -0,0 +1,173 @@
+// Graba y comprueba repeticiones de MatchSim (MatchReplay). Se graba antes de
+// un cambio y se comprueba despues: si algun paso da otro hash, dice en que
+// frame y, si la repeticion tiene snapshots, que campo cambio primero. El
+// modo latency juega con el jugador 2 detras de LoopbackRemotePolicy y
+// comprueba que cada comando llega exactamente N pasos tarde.
+//
+//   g++ -std=c++20 -O2 [-DTENNIS_FIXED_POINT -ffp-contract=off] -I.. ReplayCheck.cpp ../BallFlight.cpp ../TennisRules.cpp
+//       ../ShotTable.cpp ../MappedFile.cpp ../MatchSim.cpp ../MatchReplay.cpp ../SpinTable.cpp -o ReplayCheck
+//   ./ReplayCheck record partido.rpl [semilla] [frames] [--snapshots]
+//   ./ReplayCheck check partido.rpl
+//   ./ReplayCheck latency N [semilla] [frames]      (N = 0, 1, 2, 4, 8 o 16)
+
+#include "../MatchReplay.h"
+#include "../MatchStepper.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    // El delta varia como en un juego real (entre 50 y 75 fps).
+    const float MIN_DELTA = 1.0f / 75.0f;
+    const float MAX_DELTA = 1.0f / 50.0f;
+
+    int record(const char* path, uint64_t seed, size_t frameCount, bool withSnapshots) {
+        MatchSim sim;
+        sim.reset(seed);
+
+        MatchReplay replay;
+        replay.start(seed, withSnapshots);
+
+        std::minstd_rand deltaRng(static_cast<std::minstd_rand::result_type>(seed % 2147483646u) + 1u);
+        std::uniform_real_distribution<float> deltaDistribution(MIN_DELTA, MAX_DELTA);
+
+        MatchStepper<ScriptedAIPolicy, ScriptedAIPolicy> stepper(sim);
+        for (size_t i = 0; i < frameCount; i++) {
+            float delta = deltaDistribution(deltaRng);
+            stepper.step(delta);
+            replay.record(delta, stepper.getPlayer1Command(), stepper.getPlayer2Command(), sim);
+        }
+
+        if (!replay.save(path)) {
+            fprintf(stderr, "Error: No se pudo escribir %s\n", path);
+            return 1;
+        }
+
+        const MatchScore& score = sim.getState().score;
+        printf("%s: %zu frames, semilla %llu, marcador %s\n", path, replay.size(),
+            static_cast<unsigned long long>(seed), score.getGameText().c_str());
+        return 0;
+    }
+
+    int check(const char* path) {
+        MatchReplay replay;
+        if (!replay.load(path)) {
+            fprintf(stderr, "Error: No se pudo leer %s (o es de otra version)\n", path);
+            return 1;
+        }
+
+        MatchSim sim;
+        MatchReplay::Divergence divergence = replay.verify(sim);
+        if (!divergence.found) {
+            printf("%s: %zu frames identicos\n", path, replay.size());
+            return 0;
+        }
+
+        printf("%s: primera diferencia en el frame %zu (hash %016llx, esperado %016llx)\n", path,
+            divergence.frame, static_cast<unsigned long long>(divergence.actualHash),
+            static_cast<unsigned long long>(divergence.expectedHash));
+        if (!divergence.field.empty()) {
+            printf("  campo %s: %.9g, esperado %.9g\n", divergence.field.c_str(),
+                divergence.actualValue, divergence.expectedValue);
+        }
+        else {
+            printf("  graba con --snapshots para saber que campo cambio\n");
+        }
+        return 2;
+    }
+
+    // La IA de siempre, guardando lo que manda para compararlo con lo que llega.
+    struct SentLogPolicy {
+        std::vector<MatchSim::PlayerCommand>* sent = nullptr;
+
+        static constexpr MatchSim::CommandSource SOURCE = MatchSim::CommandSource::SCRIPTED;
+
+        MatchSim::PlayerCommand command(MatchSim& sim, int player) {
+            MatchSim::PlayerCommand command = sim.scriptedCommand(player);
+            sent->push_back(command);
+            return command;
+        }
+    };
+
+    bool sameCommand(const MatchSim::PlayerCommand& a, const MatchSim::PlayerCommand& b) {
+        return a.moveSpeed == b.moveSpeed && a.swing == b.swing && a.shot == b.shot && a.aimX == b.aimX &&
+            a.aimY == b.aimY && a.hitSpeed == b.hitSpeed && a.spin == b.spin && a.serveDelay == b.serveDelay;
+    }
+
+    template <int LatencyFrames>
+    int checkLatency(uint64_t seed, size_t frameCount) {
+        MatchSim sim;
+        sim.reset(seed);
+
+        std::vector<MatchSim::PlayerCommand> sent;
+        sent.reserve(frameCount);
+        MatchStepper<ScriptedAIPolicy, LoopbackRemotePolicy<SentLogPolicy, LatencyFrames>> stepper(sim);
+        stepper.getPlayer2().getSource().sent = &sent;
+
+        const MatchSim::PlayerCommand idle;
+        size_t points = 0;
+        for (size_t i = 0; i < frameCount; i++) {
+            if (stepper.step(1.0f / 60.0f).pointEnded) {
+                points++;
+            }
+
+            // Hasta que llega el primero se repite el comando vacio.
+            const MatchSim::PlayerCommand& expected = i >= LatencyFrames ? sent[i - LatencyFrames] : idle;
+            if (!sameCommand(stepper.getPlayer2Command(), expected)) {
+                printf("latencia %d: el comando del paso %zu no es el enviado en el paso %lld\n", LatencyFrames, i,
+                    static_cast<long long>(i) - LatencyFrames);
+                return 2;
+            }
+        }
+
+        printf("latencia %d: %zu pasos, %zu puntos, todos los comandos llegan %d pasos tarde\n", LatencyFrames,
+            frameCount, points, LatencyFrames);
+        return 0;
+    }
+
+    int latency(int latencyFrames, uint64_t seed, size_t frameCount) {
+        switch (latencyFrames) {
+        case 0: return checkLatency<0>(seed, frameCount);
+        case 1: return checkLatency<1>(seed, frameCount);
+        case 2: return checkLatency<2>(seed, frameCount);
+        case 4: return checkLatency<4>(seed, frameCount);
+        case 8: return checkLatency<8>(seed, frameCount);
+        case 16: return checkLatency<16>(seed, frameCount);
+        default:
+            fprintf(stderr, "Error: Latencia %d no compilada (0, 1, 2, 4, 8 o 16)\n", latencyFrames);
+            return 1;
+        }
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "record") == 0) {
+        uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1;
+        size_t frameCount = argc > 4 ? static_cast<size_t>(strtoull(argv[4], nullptr, 10)) : 36000;
+        bool withSnapshots = argc > 5 && strcmp(argv[5], "--snapshots") == 0;
+        return record(argv[2], seed, frameCount, withSnapshots);
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "check") == 0) {
+        return check(argv[2]);
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "latency") == 0) {
+        uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1;
+        size_t frameCount = argc > 4 ? static_cast<size_t>(strtoull(argv[4], nullptr, 10)) : 36000;
+        return latency(atoi(argv[2]), seed, frameCount);
+    }
+
+    fprintf(stderr, "Uso: %s record salida.rpl [semilla] [frames] [--snapshots]\n", argv[0]);
+    fprintf(stderr, "     %s check entrada.rpl\n", argv[0]);
+    fprintf(stderr, "     %s latency N [semilla] [frames]\n", argv[0]);
+    return 1;
+}
\ No newline at end of file
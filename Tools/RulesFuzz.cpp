@@ -0,0 +1,345 @@
+// Fuzzer de las reglas de MatchScore: juega secuencias aleatorias de puntos
+// igual que handlePointEnd (awardPoint y luego switchServer o
+// alternateServiceSide, que es lo que hace setupNextServe) y tras cada punto
+// compara con un marcador de referencia escrito aparte:
+//   - set:      el set se cierra al llegar a 6 juegos con 2 de ventaja
+//   - juego/puntos: mismo marcador que la referencia
+//   - saque:    el saque cambia de jugador en cada juego y solo entonces
+//   - lado:     el lado de saque alterna cada punto y empieza en el de iguales
+//   - texto:    getPointText (lo que pinta updateScoreDisplay) dice 40 - 40
+//               en iguales y Ad al que tiene ventaja
+//   - caja:     isInServiceBox acepta la caja en diagonal al sacador y no la otra
+// Al primer fallo reduce la secuencia (ddmin) a la mas corta que sigue
+// rompiendo el mismo invariante y la imprime como "1212..." (ganador de cada punto).
+//
+//   g++ -std=c++20 -O2 -pthread -I.. RulesFuzz.cpp ../TennisRules.cpp ../ThreadPool.cpp -o RulesFuzz
+//   ./RulesFuzz [segundos] [hilos] [semilla]
+//   ./RulesFuzz --replay 1111222212...
+
+#include "../TennisRules.h"
+#include "../ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    const size_t CASE_POINTS = 512;
+    const int CASES_PER_BATCH = 4096;
+    const float SCREEN_WIDTH = 1000.0f;
+    const float SCREEN_HEIGHT = 1000.0f;
+
+    enum Invariant {
+        NONE,
+        SET,
+        GAME,
+        POINTS,
+        SERVE,
+        SIDE,
+        TEXT,
+        BOX
+    };
+
+    const char* INVARIANT_NAMES[] = { "ninguno", "set", "juego", "puntos", "saque", "lado", "texto", "caja" };
+
+    struct Failure {
+        Invariant invariant = NONE;
+        size_t point = 0;           // indice del punto tras el que falla
+        std::string detail;
+    };
+
+    // Marcador de referencia: sets sin tie-break, como MatchScore.
+    struct ReferenceScore {
+        int points[2] = { 0, 0 };
+        int games[2] = { 0, 0 };
+        int sets[2] = { 0, 0 };
+        int server = 1;
+        int gamePoints = 0;
+
+        bool award(int winner) {
+            int loser = 1 - winner;
+            points[winner]++;
+            gamePoints++;
+            if (points[winner] < 4 || points[winner] - points[loser] < 2) {
+                return false;
+            }
+            games[winner]++;
+            points[0] = points[1] = 0;
+            gamePoints = 0;
+            server = server == 1 ? 2 : 1;
+            if (games[winner] >= 6 && games[winner] - games[loser] >= 2) {
+                sets[winner]++;
+                games[0] = games[1] = 0;
+            }
+            return true;
+        }
+
+        // El primer punto de cada juego se saca desde el lado de iguales: la
+        // derecha del sacador, que para player2 (al fondo) es la izquierda de la pantalla.
+        bool serverOnRight() const {
+            bool deuceCourt = gamePoints % 2 == 0;
+            return (server == 1) == deuceCourt;
+        }
+
+        // Textos fijos: el fuzzer no reserva memoria por punto.
+        const char* pointText() const {
+            static const char* const TEXTS[4][4] = {
+                { "0 - 0", "0 - 15", "0 - 30", "0 - 40" },
+                { "15 - 0", "15 - 15", "15 - 30", "15 - 40" },
+                { "30 - 0", "30 - 15", "30 - 30", "30 - 40" },
+                { "40 - 0", "40 - 15", "40 - 30", "40 - 40" }
+            };
+            if (points[0] >= 3 && points[1] >= 3 && points[0] != points[1]) {
+                return points[0] > points[1] ? "Ad - 40" : "40 - Ad";
+            }
+            return TEXTS[std::min(points[0], 3)][std::min(points[1], 3)];
+        }
+    };
+
+    std::string describe(const MatchScore& score) {
+        char buffer[160];
+        snprintf(buffer, sizeof(buffer), "puntos %d-%d, juegos %d-%d, sets %d-%d, saca %d, lado %s, isDeuce %d",
+            score.player1Points, score.player2Points, score.player1Games, score.player2Games,
+            score.player1Sets, score.player2Sets, score.servingPlayer, score.isDeuceSide ? "derecho" : "izquierdo",
+            score.isDeuce ? 1 : 0);
+        return buffer;
+    }
+
+    std::string describe(const ReferenceScore& reference) {
+        char buffer[160];
+        snprintf(buffer, sizeof(buffer), "puntos %d-%d, juegos %d-%d, sets %d-%d, saca %d, lado %s",
+            reference.points[0], reference.points[1], reference.games[0], reference.games[1],
+            reference.sets[0], reference.sets[1], reference.server, reference.serverOnRight() ? "derecho" : "izquierdo");
+        return buffer;
+    }
+
+    Invariant check(const MatchScore& score, const ReferenceScore& reference, bool gameWon, int serverBefore,
+        bool expectedGameWon, std::string* detail) {
+        Invariant failed = NONE;
+        if (score.player1Sets != reference.sets[0] || score.player2Sets != reference.sets[1]) {
+            failed = SET;
+        }
+        else if (score.player1Games != reference.games[0] || score.player2Games != reference.games[1]) {
+            failed = GAME;
+        }
+        else if (score.player1Points != reference.points[0] || score.player2Points != reference.points[1]) {
+            failed = POINTS;
+        }
+        else if (gameWon != expectedGameWon || score.servingPlayer != reference.server ||
+            (score.servingPlayer != serverBefore + 1) != gameWon) {
+            failed = SERVE;
+        }
+        else if (score.isDeuceSide != reference.serverOnRight()) {
+            failed = SIDE;
+        }
+        else {
+            // Centro de la caja en diagonal al sacador y el de su simetrica.
+            float boxY = (reference.server == 1 ? 0.725f : 0.275f) * SCREEN_HEIGHT;
+            float offset = 0.1f * SCREEN_WIDTH;
+            float boxX = SCREEN_WIDTH * 0.5f + (reference.serverOnRight() ? -offset : offset);
+            float mirrorX = SCREEN_WIDTH - boxX;
+            if (!score.isInServiceBox(boxX, boxY, SCREEN_WIDTH, SCREEN_HEIGHT) ||
+                score.isInServiceBox(mirrorX, boxY, SCREEN_WIDTH, SCREEN_HEIGHT)) {
+                failed = BOX;
+            }
+            else if (score.getPointText() != reference.pointText()) {
+                failed = TEXT;
+            }
+        }
+
+        if (failed != NONE && detail) {
+            *detail = "MatchScore: " + describe(score) + " \"" + score.getPointText() + "\"\n" +
+                "  esperado:   " + describe(reference) + " \"" + reference.pointText() + "\"";
+        }
+        return failed;
+    }
+
+    // winners[i] es 0 si el punto i lo gana player1 y 1 si lo gana player2.
+    Failure runSequence(const uint8_t* winners, size_t count, bool withDetail) {
+        MatchScore score;
+        ReferenceScore reference;
+        Failure failure;
+
+        for (size_t i = 0; i < count; i++) {
+            int serverBefore = score.servingPlayer - 1;
+            bool expectedGameWon = reference.award(winners[i]);
+
+            // Lo mismo que TennisScene::handlePointEnd.
+            bool gameWon = score.awardPoint(winners[i] == 0);
+            if (gameWon) {
+                score.switchServer();
+            }
+            else {
+                score.alternateServiceSide();
+            }
+
+            Invariant failed = check(score, reference, gameWon, serverBefore, expectedGameWon,
+                withDetail ? &failure.detail : nullptr);
+            if (failed != NONE) {
+                failure.invariant = failed;
+                failure.point = i;
+                return failure;
+            }
+        }
+        return failure;
+    }
+
+    uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Cada caso tiene su propio sesgo para que haya sets de los dos lados,
+    // palizas y juegos largos de ventajas.
+    void generateCase(uint64_t caseSeed, uint8_t* winners, size_t count) {
+        uint64_t state = caseSeed;
+        uint32_t threshold = static_cast<uint32_t>(splitmix64(state) % 0x60000000ull) + 0x50000000u;
+        for (size_t i = 0; i < count; i += 2) {
+            uint64_t bits = splitmix64(state);
+            winners[i] = static_cast<uint32_t>(bits) >= threshold;
+            if (i + 1 < count) {
+                winners[i + 1] = static_cast<uint32_t>(bits >> 32) >= threshold;
+            }
+        }
+    }
+
+    bool failsWith(const std::vector<uint8_t>& winners, Invariant invariant) {
+        return runSequence(winners.data(), winners.size(), false).invariant == invariant;
+    }
+
+    // ddmin: quita trozos cada vez mas pequenos mientras siga fallando igual.
+    std::vector<uint8_t> minimize(std::vector<uint8_t> winners, Invariant invariant) {
+        size_t chunks = 2;
+        while (winners.size() >= 2) {
+            size_t chunk = (winners.size() + chunks - 1) / chunks;
+            bool reduced = false;
+            for (size_t start = 0; start < winners.size(); start += chunk) {
+                std::vector<uint8_t> candidate(winners.begin(), winners.begin() + start);
+                candidate.insert(candidate.end(), winners.begin() + std::min(start + chunk, winners.size()), winners.end());
+                if (failsWith(candidate, invariant)) {
+                    winners.swap(candidate);
+                    chunks = std::max<size_t>(chunks - 1, 2);
+                    reduced = true;
+                    break;
+                }
+            }
+            if (!reduced) {
+                if (chunk == 1) {
+                    break;
+                }
+                chunks = std::min(chunks * 2, winners.size());
+            }
+        }
+        return winners;
+    }
+
+    std::string toText(const std::vector<uint8_t>& winners) {
+        std::string text;
+        for (uint8_t winner : winners) {
+            text += winner ? '2' : '1';
+        }
+        return text;
+    }
+
+    int report(const std::vector<uint8_t>& winners) {
+        Failure failure = runSequence(winners.data(), winners.size(), true);
+        if (failure.invariant == NONE) {
+            printf("%zu puntos sin fallos\n", winners.size());
+            return 0;
+        }
+        printf("Falla el invariante \"%s\" en el punto %zu de %zu\n  %s\n  secuencia: %s\n",
+            INVARIANT_NAMES[failure.invariant], failure.point + 1, winners.size(), failure.detail.c_str(),
+            toText(std::vector<uint8_t>(winners.begin(), winners.begin() + failure.point + 1)).c_str());
+        return 2;
+    }
+
+    int replay(const char* text) {
+        std::vector<uint8_t> winners;
+        for (const char* c = text; *c; c++) {
+            if (*c != '1' && *c != '2') {
+                fprintf(stderr, "Error: La secuencia solo puede tener 1 y 2\n");
+                return 1;
+            }
+            winners.push_back(*c == '2');
+        }
+        return report(winners);
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "--replay") == 0) {
+        return replay(argv[2]);
+    }
+
+    double seconds = argc > 1 ? atof(argv[1]) : 10.0;
+    int threadCount = argc > 2 ? atoi(argv[2]) : 4;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1;
+    if (seconds <= 0.0 || threadCount <= 0) {
+        fprintf(stderr, "Uso: %s [segundos] [hilos] [semilla]\n", argv[0]);
+        fprintf(stderr, "     %s --replay 1212...\n", argv[0]);
+        return 1;
+    }
+
+    ThreadPool pool(threadCount);
+    std::atomic<uint64_t> nextBatch{ 0 };
+    std::atomic<uint64_t> points{ 0 };
+    std::atomic<bool> failed{ false };
+    uint64_t failedCase = 0;
+    Invariant failedInvariant = NONE;
+    std::atomic_flag failureClaimed = ATOMIC_FLAG_INIT;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+    auto body = [&](int begin, int end) {
+        std::vector<uint8_t> winners(CASE_POINTS);
+        for (int worker = begin; worker < end; worker++) {
+            while (!failed.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < deadline) {
+                uint64_t batch = nextBatch.fetch_add(1, std::memory_order_relaxed);
+                for (int i = 0; i < CASES_PER_BATCH; i++) {
+                    uint64_t caseSeed = seed * 0x100000000ull + batch * CASES_PER_BATCH + i;
+                    generateCase(caseSeed, winners.data(), winners.size());
+                    Failure failure = runSequence(winners.data(), winners.size(), false);
+                    if (failure.invariant != NONE) {
+                        if (!failureClaimed.test_and_set()) {
+                            failedCase = caseSeed;
+                            failedInvariant = failure.invariant;
+                            failed = true;
+                        }
+                        points.fetch_add(static_cast<uint64_t>(i) * CASE_POINTS + failure.point + 1, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                points.fetch_add(static_cast<uint64_t>(CASES_PER_BATCH) * CASE_POINTS, std::memory_order_relaxed);
+            }
+        }
+    };
+    pool.parallelFor(threadCount, 1, body);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%llu puntos en %.2f s (%.1f M puntos/s, %d hilos)\n", static_cast<unsigned long long>(points.load()),
+        elapsed, points.load() / elapsed / 1e6, threadCount);
+    if (!failed) {
+        printf("Ningun invariante falla\n");
+        return 0;
+    }
+
+    std::vector<uint8_t> winners(CASE_POINTS);
+    generateCase(failedCase, winners.data(), winners.size());
+    Failure failure = runSequence(winners.data(), winners.size(), false);
+    winners.resize(failure.point + 1);
+    std::vector<uint8_t> minimal = minimize(winners, failedInvariant);
+    printf("Caso %llu: %zu puntos, reducido a %zu\n", static_cast<unsigned long long>(failedCase), winners.size(), minimal.size());
+    return report(minimal);
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+// Genera Resources/shot_table.bin simulando sin ventana cada devolucion
+// posible de la IA con la misma fisica que TennisScene (BallFlight).
+//
+//   g++ -std=c++17 -O2 -I.. ShotTableBuilder.cpp ../BallFlight.cpp ../ShotTable.cpp ../MappedFile.cpp -o ShotTableBuilder
+//   ./ShotTableBuilder ../Resources/shot_table.bin
+
+#include "../BallFlight.h"
+#include "../ShotTable.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    const float DESIGN_WIDTH = 1280.0f;
+    const float DESIGN_HEIGHT = 720.0f;
+    const float STEP = 1.0f / 60.0f;
+    const float MAX_FLIGHT_TIME = 4.0f;
+    const float ARRIVAL_Y = 0.2f;
+    const float SIDE_MARGIN = 0.03f;
+
+    // Puntua una devolucion: la pelota debe llegar a la linea de fondo del
+    // jugador sin irse fuera ni tocar la red. Se premia alejarla de donde se
+    // supone que esta el rival (enfrente de la IA) y la velocidad.
+    float scoreReturn(const CourtGeometry& court, float ballX, float ballY, float aiX, float targetX, float speed) {
+        BallState ball;
+        ball.x = ballX;
+        ball.y = ballY;
+        float dx = (targetX - ballX) / (court.width * 0.5f);
+        float dy = -2.0f;
+        float length = std::sqrt(dx * dx + dy * dy);
+        ball.vx = dx / length * speed;
+        ball.vy = dy / length * speed;
+
+        float leftLimit = (court.width - court.courtWidth) / 2 + court.width * SIDE_MARGIN;
+        float rightLimit = (court.width + court.courtWidth) / 2 - court.width * SIDE_MARGIN;
+
+        for (float t = 0.0f; t < MAX_FLIGHT_TIME; t += STEP) {
+            bool player1Won = false;
+            if (BallFlight::step(ball, STEP, court, player1Won) != FlightResult::IN_PLAY) {
+                return -1.0f;
+            }
+            if (ball.x < leftLimit || ball.x > rightLimit) {
+                return -1.0f;
+            }
+            if (ball.y <= court.height * ARRIVAL_Y) {
+                float spread = std::abs(ball.x - aiX) / court.courtWidth;
+                float pace = 1.0f / (1.0f + t);
+                return spread + 0.25f * pace;
+            }
+            if (BallFlight::isOutOfCourt(ball, court)) {
+                return -1.0f;
+            }
+        }
+        return -1.0f;
+    }
+
+    ShotTable::Entry bestReturn(const CourtGeometry& court, float ballX, float ballY, float aiX) {
+        ShotTable::Entry best = { ShotTable::TARGET_BINS / 2, 0 };
+        float bestScore = -1.0f;
+
+        for (int target = 0; target < ShotTable::TARGET_BINS; target++) {
+            for (int speed = 0; speed < ShotTable::SPEED_BINS; speed++) {
+                float score = scoreReturn(court, ballX, ballY, aiX,
+                    ShotTable::targetForBin(target) * court.width,
+                    ShotTable::speedForBin(speed));
+                if (score > bestScore) {
+                    bestScore = score;
+                    best.target = static_cast<uint8_t>(target);
+                    best.speed = static_cast<uint8_t>(speed);
+                }
+            }
+        }
+        return best;
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    const char* outputPath = argc > 1 ? argv[1] : "Resources/shot_table.bin";
+    CourtGeometry court = CourtGeometry::fromVisibleSize(DESIGN_WIDTH, DESIGN_HEIGHT);
+
+    std::vector<ShotTable::Entry> entries(ShotTable::ENTRY_COUNT);
+    int playable = 0;
+
+    for (int bx = 0; bx < ShotTable::BALL_X_BINS; bx++) {
+        for (int by = 0; by < ShotTable::BALL_Y_BINS; by++) {
+            for (int ax = 0; ax < ShotTable::AI_X_BINS; ax++) {
+                float ballX = ShotTable::binCenter(bx, ShotTable::MIN_X, ShotTable::MAX_X, ShotTable::BALL_X_BINS) * court.width;
+                float ballY = ShotTable::binCenter(by, ShotTable::MIN_BALL_Y, ShotTable::MAX_BALL_Y, ShotTable::BALL_Y_BINS) * court.height;
+                float aiX = ShotTable::binCenter(ax, ShotTable::MIN_X, ShotTable::MAX_X, ShotTable::AI_X_BINS) * court.width;
+
+                ShotTable::Entry entry = bestReturn(court, ballX, ballY, aiX);
+                if (scoreReturn(court, ballX, ballY, aiX,
+                    ShotTable::targetForBin(entry.target) * court.width,
+                    ShotTable::speedForBin(entry.speed)) >= 0.0f) {
+                    playable++;
+                }
+
+                // El golpe de la IA sustituye la velocidad entrante, asi que con
+                // la fisica actual todas las celdas de velocidad comparten entrada.
+                for (int vx = 0; vx < ShotTable::VEL_X_BINS; vx++) {
+                    for (int vy = 0; vy < ShotTable::VEL_Y_BINS; vy++) {
+                        entries[ShotTable::indexFor(bx, by, vx, vy, ax)] = entry;
+                    }
+                }
+            }
+        }
+    }
+
+    ShotTable::Header header = {};
+    header.magic = ShotTable::MAGIC;
+    header.version = ShotTable::VERSION;
+    header.entryCount = ShotTable::ENTRY_COUNT;
+    header.dims[0] = ShotTable::BALL_X_BINS;
+    header.dims[1] = ShotTable::BALL_Y_BINS;
+    header.dims[2] = ShotTable::VEL_X_BINS;
+    header.dims[3] = ShotTable::VEL_Y_BINS;
+    header.dims[4] = ShotTable::AI_X_BINS;
+    header.targetBins = ShotTable::TARGET_BINS;
+    header.speedBins = ShotTable::SPEED_BINS;
+
+    FILE* file = fopen(outputPath, "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "Error: No se pudo abrir %s\n", outputPath);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(entries.data(), sizeof(ShotTable::Entry), entries.size(), file);
+    fclose(file);
+
+    int cells = ShotTable::BALL_X_BINS * ShotTable::BALL_Y_BINS * ShotTable::AI_X_BINS;
+    printf("%s: %d entradas, %d/%d posiciones con devolucion valida\n",
+        outputPath, ShotTable::ENTRY_COUNT, playable, cells);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Torneo de variantes de la IA de MatchSim con Elo. El perfil 0 es la IA
+// de TennisScene; los demas salen al azar de la semilla. La liga enfrenta a
+// todos contra todos "vueltas" veces; el cuadro siembra por el Elo que haya
+// (tras --then-knockout, el de la liga).
+//
+//   g++ -std=c++20 -O2 -pthread -I.. TournamentRunner.cpp ../Tournament.cpp ../BallFlight.cpp ../TennisRules.cpp
+//       ../ShotTable.cpp ../MappedFile.cpp ../MatchSim.cpp ../MatchEvents.cpp ../ThreadPool.cpp ../SpinTable.cpp
+//       -o TournamentRunner
+//   ./TournamentRunner league 64 50 16              (64 perfiles, 50 vueltas: 100800 partidos)
+//   ./TournamentRunner knockout 100 16 7
+//   ./TournamentRunner league 32 10 16 1 --then-knockout --shot-table ../Resources/shot_table.bin
+
+#include "../ShotTable.h"
+#include "../Tournament.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace EpicGame;
+
+namespace {
+
+    std::vector<Tournament::Entrant> makeEntrants(int count, uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<float> moveFactor(0.6f, 1.0f);
+        std::uniform_real_distribution<float> reach(40.0f, 80.0f);
+        std::uniform_int_distribution<int> hitChance(50, 95);
+        std::uniform_real_distribution<float> hitSpeedScale(0.85f, 1.15f);
+        std::uniform_real_distribution<float> aimSpread(0.05f, 0.3f);
+        std::uniform_int_distribution<int> spinShotChance(0, 60);
+
+        std::vector<Tournament::Entrant> entrants(count);
+        for (int i = 0; i < count; i++) {
+            char name[16];
+            snprintf(name, sizeof(name), "IA-%03d", i);
+            entrants[i].name = name;
+            if (i == 0) {
+                continue;
+            }
+            MatchSim::AIProfile& profile = entrants[i].profile;
+            profile.moveFactor = moveFactor(rng);
+            profile.reach = reach(rng);
+            profile.hitChance = hitChance(rng);
+            profile.hitSpeedScale = hitSpeedScale(rng);
+            profile.aimSpread = aimSpread(rng);
+            profile.useShotTable = rng() % 2 == 0;
+            profile.spinShotChance = spinShotChance(rng);
+        }
+        return entrants;
+    }
+
+    void runStage(Tournament& tournament, ThreadPool& pool, const char* label) {
+        auto start = std::chrono::steady_clock::now();
+        tournament.run(pool);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t played = 0;
+        size_t timedOut = 0;
+        for (const Tournament::Match& match : tournament.getMatches()) {
+            played += match.played ? 1 : 0;
+            timedOut += match.timedOut ? 1 : 0;
+        }
+        uint64_t steps = tournament.getTotalSteps();
+        printf("%s: %zu partidos (%zu sin acabar el set), %llu pasos en %.2f s (%.0f partidos/s, %.1f M pasos/s, %d hilos)\n",
+            label, played, timedOut, static_cast<unsigned long long>(steps), seconds, played / seconds,
+            steps / seconds / 1e6, pool.getThreadCount());
+    }
+
+    void printStandings(const std::vector<Tournament::Entrant>& entrants) {
+        std::vector<int> order(entrants.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = static_cast<int>(i);
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [&](int a, int b) { return entrants[a].rating > entrants[b].rating; });
+
+        printf("pos  nombre   elo      G      P     mov  alcance  golpe  vel   error tabla efecto\n");
+        for (size_t pos = 0; pos < order.size(); pos++) {
+            const Tournament::Entrant& entrant = entrants[order[pos]];
+            const MatchSim::AIProfile& profile = entrant.profile;
+            printf("%3zu  %-7s %7.1f %6u %6u  %.2f  %5.1f    %3d%%  %.2f  %.2f  %s    %3d%%\n", pos + 1, entrant.name.c_str(),
+                entrant.rating, entrant.wins, entrant.losses, profile.moveFactor, profile.reach, profile.hitChance,
+                profile.hitSpeedScale, profile.aimSpread, profile.useShotTable ? "si" : "no", profile.spinShotChance);
+        }
+    }
+
+}
+
+int main(int argc, char* argv[])
+{
+    bool league = argc > 1 && strcmp(argv[1], "league") == 0;
+    bool knockout = argc > 1 && strcmp(argv[1], "knockout") == 0;
+    int argIndex = 2;
+    int profileCount = argc > argIndex ? atoi(argv[argIndex++]) : 0;
+    int legs = league && argc > argIndex ? atoi(argv[argIndex++]) : 1;
+    int threadCount = argc > argIndex ? atoi(argv[argIndex++]) : 4;
+    uint64_t seed = argc > argIndex && argv[argIndex][0] != '-' ? strtoull(argv[argIndex++], nullptr, 10) : 1;
+
+    bool thenKnockout = false;
+    for (; argIndex < argc; argIndex++) {
+        if (strcmp(argv[argIndex], "--then-knockout") == 0) {
+            thenKnockout = true;
+        }
+        else if (strcmp(argv[argIndex], "--shot-table") == 0 && argIndex + 1 < argc) {
+            if (!ShotTable::getInstance()->load(argv[++argIndex])) {
+                fprintf(stderr, "Error: No se pudo cargar %s\n", argv[argIndex]);
+                return 1;
+            }
+        }
+    }
+
+    if ((!league && !knockout) || profileCount < 2 || legs <= 0 || threadCount <= 0) {
+        fprintf(stderr, "Uso: %s league perfiles vueltas hilos [semilla] [--then-knockout] [--shot-table tabla.bin]\n", argv[0]);
+        fprintf(stderr, "     %s knockout perfiles hilos [semilla] [--shot-table tabla.bin]\n", argv[0]);
+        return 1;
+    }
+
+    ThreadPool pool(threadCount);
+    Tournament tournament(makeEntrants(profileCount, seed));
+
+    if (league) {
+        tournament.buildLeague(legs, seed);
+        runStage(tournament, pool, "Liga");
+    }
+    if (knockout || thenKnockout) {
+        tournament.buildKnockout(seed);
+        runStage(tournament, pool, "Cuadro");
+        int champion = tournament.getChampion();
+        if (champion >= 0) {
+            printf("Campeon: %s\n", tournament.getEntrants()[champion].name.c_str());
+        }
+    }
+
+    printStandings(tournament.getEntrants());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "Tournament.h"
+#include "MatchStepper.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace EpicGame {
+
+    Tournament::Tournament(const std::vector<Entrant>& entrants)
+        : entrants(entrants) {
+    }
+
+    void Tournament::clearMatches() {
+        matches.clear();
+        finished.clear();
+        ready.clear();
+        ratingCursor = 0;
+        knockout = false;
+    }
+
+    void Tournament::buildLeague(int legs, uint64_t seed) {
+        clearMatches();
+        int count = static_cast<int>(entrants.size());
+        matches.reserve(static_cast<size_t>(std::max(legs, 0)) * count * (count - 1) / 2);
+
+        for (int leg = 0; leg < legs; leg++) {
+            for (int a = 0; a < count; a++) {
+                for (int b = a + 1; b < count; b++) {
+                    Match match;
+                    match.player1 = leg % 2 == 0 ? a : b;
+                    match.player2 = leg % 2 == 0 ? b : a;
+                    match.round = leg;
+                    match.seed = seed + matches.size() + 1;
+                    matches.push_back(match);
+                }
+            }
+        }
+    }
+
+    void Tournament::buildKnockout(uint64_t seed) {
+        clearMatches();
+        knockout = true;
+        int count = static_cast<int>(entrants.size());
+        if (count < 2) {
+            return;
+        }
+
+        std::vector<int> bySeed(count);
+        for (int i = 0; i < count; i++) {
+            bySeed[i] = i;
+        }
+        std::stable_sort(bySeed.begin(), bySeed.end(),
+            [this](int a, int b) { return entrants[a].rating > entrants[b].rating; });
+
+        // Orden clasico del cuadro: 1-8, 4-5, 2-7, 3-6... los dos mejores
+        // solo pueden cruzarse en la final.
+        int size = 1;
+        std::vector<int> order = { 0 };
+        while (size < count) {
+            size *= 2;
+            std::vector<int> expanded;
+            expanded.reserve(size);
+            for (int position : order) {
+                expanded.push_back(position);
+                expanded.push_back(size - 1 - position);
+            }
+            order.swap(expanded);
+        }
+
+        // Ronda 0 primero; el partido k de una ronda alimenta al k / 2 de la siguiente.
+        int roundStart = 0;
+        int roundSize = size / 2;
+        for (int round = 0; roundSize >= 1; round++) {
+            for (int k = 0; k < roundSize; k++) {
+                Match match;
+                match.round = round;
+                match.seed = seed + matches.size() + 1;
+                if (round == 0) {
+                    int seed1 = order[2 * k];
+                    int seed2 = order[2 * k + 1];
+                    match.player1 = seed1 < count ? bySeed[seed1] : -1;
+                    match.player2 = seed2 < count ? bySeed[seed2] : -1;
+                }
+                else {
+                    match.pending = 2;
+                }
+                if (roundSize > 1) {
+                    match.next = roundStart + roundSize + k / 2;
+                    match.nextSlot = k % 2 + 1;
+                }
+                matches.push_back(match);
+            }
+            roundStart += roundSize;
+            roundSize /= 2;
+        }
+    }
+
+    void Tournament::run(ThreadPool& pool) {
+        finished.assign(matches.size(), 0);
+        remaining = matches.size();
+        ratingCursor = 0;
+        ready.clear();
+
+        std::vector<int> initial;
+        for (size_t i = 0; i < matches.size(); i++) {
+            if (matches[i].pending == 0) {
+                initial.push_back(static_cast<int>(i));
+            }
+        }
+        // Los pases directos se resuelven antes de empezar, en un solo hilo;
+        // los partidos que liberan entran en la cola desde advanceWinner.
+        for (int index : initial) {
+            Match& match = matches[index];
+            if (match.player1 >= 0 && match.player2 >= 0) {
+                ready.push_back(index);
+            }
+            else {
+                match.winner = std::max(match.player1, match.player2);
+                finishMatch(index);
+            }
+        }
+
+        int threadCount = pool.getThreadCount();
+        std::vector<std::unique_ptr<Worker>> workers;
+        for (int i = 0; i < threadCount; i++) {
+            workers.emplace_back(new Worker());
+        }
+
+        auto body = [&](int begin, int end) {
+            for (int w = begin; w < end; w++) {
+                workerLoop(*workers[w]);
+            }
+        };
+        pool.parallelFor(threadCount, 1, body);
+    }
+
+    void Tournament::workerLoop(Worker& worker) {
+        for (;;) {
+            int index;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                readyCondition.wait(lock, [this] { return !ready.empty() || remaining == 0; });
+                if (ready.empty()) {
+                    return;
+                }
+                index = ready.front();
+                ready.pop_front();
+            }
+
+            // Nadie mas toca este partido hasta que se marca como terminado.
+            playMatch(worker, matches[index]);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finishMatch(index);
+        }
+    }
+
+    void Tournament::playMatch(Worker& worker, Match& match) {
+        MatchSim& sim = worker.sim;
+        sim.reset(match.seed);
+
+        ProfileAIPolicy player1 = { entrants[match.player1].profile };
+        ProfileAIPolicy player2 = { entrants[match.player2].profile };
+        MatchStepper<ProfileAIPolicy, ProfileAIPolicy> stepper(sim, player1, player2);
+
+        match.played = true;
+        match.winner = -1;
+        uint64_t step = 0;
+        while (step < MAX_MATCH_STEPS) {
+            MatchSim::StepResult result = stepper.step(STEP);
+            step++;
+
+            const MatchScore& score = sim.getState().score;
+            if (result.gameWon && score.player1Sets + score.player2Sets > 0) {
+                match.winner = result.player1Won ? match.player1 : match.player2;
+                break;
+            }
+        }
+        match.steps = step;
+
+        if (match.winner < 0) {
+            // Sin set cerrado: juegos, luego puntos; si empatan, el jugador 1.
+            const MatchScore& score = sim.getState().score;
+            match.timedOut = true;
+            bool player2Ahead = score.player2Games != score.player1Games ?
+                score.player2Games > score.player1Games : score.player2Points > score.player1Points;
+            match.winner = player2Ahead ? match.player2 : match.player1;
+        }
+    }
+
+    void Tournament::finishMatch(int index) {
+        finished[index] = 1;
+        remaining--;
+        advanceWinner(index);
+        applyRatings();
+
+        if (remaining == 0) {
+            readyCondition.notify_all();
+        }
+    }
+
+    void Tournament::advanceWinner(int index) {
+        const Match& match = matches[index];
+        if (match.next < 0) {
+            return;
+        }
+
+        Match& next = matches[match.next];
+        if (match.nextSlot == 1) {
+            next.player1 = match.winner;
+        }
+        else {
+            next.player2 = match.winner;
+        }
+        if (--next.pending == 0) {
+            ready.push_back(match.next);
+            readyCondition.notify_one();
+        }
+    }
+
+    void Tournament::applyRatings() {
+        while (ratingCursor < matches.size() && finished[ratingCursor]) {
+            const Match& match = matches[ratingCursor++];
+            if (!match.played) {
+                continue;
+            }
+
+            Entrant& winner = entrants[match.winner];
+            Entrant& loser = entrants[match.winner == match.player1 ? match.player2 : match.player1];
+            double expected = 1.0 / (1.0 + std::pow(10.0, (loser.rating - winner.rating) / 400.0));
+            double change = K_FACTOR * (1.0 - expected);
+            winner.rating += change;
+            loser.rating -= change;
+            winner.wins++;
+            loser.losses++;
+        }
+    }
+
+    int Tournament::getChampion() const {
+        if (!knockout || matches.empty()) {
+            return -1;
+        }
+        return matches.back().winner;
+    }
+
+    uint64_t Tournament::getTotalSteps() const {
+        uint64_t total = 0;
+        for (const Match& match : matches) {
+            total += match.steps;
+        }
+        return total;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef __TOURNAMENT_H__
+#define __TOURNAMENT_H__
+
+#include "MatchSim.h"
+#include "ThreadPool.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EpicGame {
+
+    // Torneo de perfiles de IA jugado con MatchSim (un set por partido). Los
+    // partidos forman un grafo de dependencias: en una liga todos estan listos
+    // desde el principio; en un cuadro cada partido espera a sus dos partidos
+    // previos y se juega en cuanto acaban, sin esperar al resto de la ronda.
+    // Cada hilo del pool saca partidos de la cola de listos hasta que no queda
+    // ninguno. El Elo se actualiza segun acaban los partidos, pero siempre en
+    // el orden de la lista de partidos, asi que el resultado no depende del
+    // numero de hilos.
+    class Tournament {
+    public:
+        static constexpr double INITIAL_RATING = 1500.0;
+        static constexpr double K_FACTOR = 24.0;
+        static constexpr float STEP = 1.0f / 60.0f;
+        // Una hora de juego como maximo; luego gana quien va por delante.
+        static const uint64_t MAX_MATCH_STEPS = 60ull * 60ull * 60ull;
+
+        struct Entrant {
+            std::string name;
+            MatchSim::AIProfile profile;
+            double rating = INITIAL_RATING;
+            uint32_t wins = 0;
+            uint32_t losses = 0;
+        };
+
+        struct Match {
+            int player1 = -1;           // indice de Entrant, -1 hasta que acaba el previo
+            int player2 = -1;
+            int next = -1;              // partido al que pasa el ganador
+            int nextSlot = 0;           // 1 o 2 en ese partido
+            int pending = 0;            // partidos previos sin terminar
+            int round = 0;
+            uint64_t seed = 0;
+            int winner = -1;
+            uint64_t steps = 0;
+            bool timedOut = false;
+            bool played = false;        // false en los pases directos del cuadro
+        };
+
+        explicit Tournament(const std::vector<Entrant>& entrants);
+        Tournament(const Tournament&) = delete;
+        Tournament& operator=(const Tournament&) = delete;
+
+        // Todos contra todos, legs veces; el jugador 1 se alterna en cada vuelta.
+        void buildLeague(int legs, uint64_t seed);
+        // Eliminatoria con siembra por rating (1 contra el ultimo...). Si no
+        // son potencia de dos, los mejores pasan la primera ronda sin jugar.
+        void buildKnockout(uint64_t seed);
+
+        // Juega todos los partidos con los hilos del pool y vuelve al acabar.
+        void run(ThreadPool& pool);
+
+        const std::vector<Entrant>& getEntrants() const { return entrants; }
+        const std::vector<Match>& getMatches() const { return matches; }
+        // Ganador del cuadro, o -1 si es una liga o no se ha jugado.
+        int getChampion() const;
+        uint64_t getTotalSteps() const;
+
+    private:
+        struct Worker {
+            MatchSim sim;
+        };
+
+        void clearMatches();
+        void workerLoop(Worker& worker);
+        void playMatch(Worker& worker, Match& match);
+        // Con el cerrojo: libera los partidos que dependian de este y aplica
+        // el Elo de todos los terminados que ya tocan.
+        void finishMatch(int index);
+        void advanceWinner(int index);
+        void applyRatings();
+
+        std::vector<Entrant> entrants;
+        std::vector<Match> matches;
+        bool knockout = false;
+
+        std::mutex mutex;
+        std::condition_variable readyCondition;
+        std::deque<int> ready;
+        std::vector<uint8_t> finished;
+        size_t remaining = 0;
+        size_t ratingCursor = 0;
+    };
+
+}
+
+#endif
\ No newline at end of file
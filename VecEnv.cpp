@@ -0,0 +1,126 @@
+#include "VecEnv.h"
+
+namespace EpicGame {
+
+    static const int GRAIN_SIZE = 64;
+
+    VecEnv::VecEnv(int envCount, int threadCount, float frameTime)
+        : envs(envCount), seeds(envCount, 0), results(envCount), flying(envCount, 0),
+          ballX(envCount), ballY(envCount), ballVX(envCount), ballVY(envCount), frameTime(frameTime) {
+        steppers.reserve(envCount);
+        for (MatchSim& env : envs) {
+            steppers.emplace_back(env);
+        }
+        if (threadCount > 1) {
+            pool.reset(new ThreadPool(threadCount));
+        }
+    }
+
+    void VecEnv::reset(const uint64_t* newSeeds, float* observations) {
+        for (int i = 0; i < size(); i++) {
+            seeds[i] = newSeeds[i];
+            envs[i].reset(seeds[i]);
+            writeObservation(i, observations + i * OBSERVATION_SIZE);
+        }
+    }
+
+    void VecEnv::step(const uint8_t* actions, float* observations, float* rewards, uint8_t* dones) {
+        stepActions = actions;
+        stepObservations = observations;
+        stepRewards = rewards;
+        stepDones = dones;
+
+        auto body = [this](int begin, int end) { stepRange(begin, end); };
+        if (pool) {
+            pool->parallelFor(size(), GRAIN_SIZE, body);
+        }
+        else {
+            body(0, size());
+        }
+    }
+
+    void VecEnv::stepRange(int begin, int end) {
+        // Primera mitad del paso de cada partido: comandos, golpe y
+        // movimiento de player1, y la pelota que queda por integrar.
+        for (int i = begin; i < end; i++) {
+            uint8_t action = stepActions[i];
+            HumanPolicy& agent = steppers[i].getPlayer1();
+            agent.left = action == LEFT || action == SWING_LEFT;
+            agent.right = action == RIGHT || action == SWING_RIGHT;
+            agent.space = action == SWING || action == SWING_LEFT || action == SWING_RIGHT;
+
+            results[i] = MatchSim::StepResult();
+            flying[i] = steppers[i].beginStep(frameTime, results[i]) ? 1 : 0;
+        }
+
+#ifdef TENNIS_FIXED_POINT
+        for (int i = begin; i < end; i++) {
+            const BallStateT<Scalar>& ball = envs[i].getFlightBall();
+            ballX[i] = ball.x.raw;
+            ballY[i] = ball.y.raw;
+            ballVX[i] = ball.vx.raw;
+            ballVY[i] = ball.vy.raw;
+        }
+        BallFlight::integrateBatch(ballX.data() + begin, ballY.data() + begin, ballVX.data() + begin,
+            ballVY.data() + begin, flying.data() + begin, end - begin, Scalar(frameTime));
+        for (int i = begin; i < end; i++) {
+            if (flying[i]) {
+                BallStateT<Scalar>& ball = envs[i].getFlightBall();
+                ball.x = Fixed::fromRaw(ballX[i]);
+                ball.y = Fixed::fromRaw(ballY[i]);
+                ball.vx = Fixed::fromRaw(ballVX[i]);
+                ball.vy = Fixed::fromRaw(ballVY[i]);
+            }
+        }
+#else
+        for (int i = begin; i < end; i++) {
+            if (flying[i]) {
+                BallFlight::integrate(envs[i].getFlightBall(), Scalar(frameTime));
+            }
+        }
+#endif
+
+        for (int i = begin; i < end; i++) {
+            MatchSim::StepResult& result = results[i];
+            if (flying[i]) {
+                steppers[i].finishStep(result);
+            }
+
+            float reward = 0.0f;
+            if (result.pointEnded) {
+                reward = result.player1Won ? 1.0f : -1.0f;
+            }
+            stepRewards[i] = reward;
+            stepDones[i] = result.gameWon ? 1 : 0;
+
+            if (result.gameWon) {
+                seeds[i]++;
+                envs[i].reset(seeds[i]);
+            }
+
+            writeObservation(i, stepObservations + i * OBSERVATION_SIZE);
+        }
+    }
+
+    void VecEnv::writeObservation(int index, float* observation) const {
+        const MatchSim& env = envs[index];
+        const MatchSim::State& state = env.getState();
+        const CourtGeometryT<Scalar>& court = env.getCourt();
+        float width = toFloat(court.width);
+        float height = toFloat(court.height);
+
+        observation[0] = toFloat(state.ball.x) / width;
+        observation[1] = toFloat(state.ball.y) / height;
+        observation[2] = toFloat(state.ball.vx) / 1000.0f;
+        observation[3] = toFloat(state.ball.vy) / 1000.0f;
+        observation[4] = toFloat(state.player1X) / width;
+        observation[5] = toFloat(state.player2X) / width;
+        observation[6] = state.ballInPlay ? 1.0f : 0.0f;
+        observation[7] = state.score.servingPlayer == 1 ? 1.0f : 0.0f;
+        observation[8] = static_cast<float>(state.serveState) / 3.0f;
+        observation[9] = static_cast<float>(state.gameState) / 2.0f;
+        observation[10] = state.score.isDeuceSide ? 1.0f : 0.0f;
+        observation[11] = static_cast<float>(state.score.player1Points - state.score.player2Points) / 4.0f;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef __VEC_ENV_H__
+#define __VEC_ENV_H__
+
+#include "MatchSim.h"
+#include "MatchStepper.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace EpicGame {
+
+    // Entorno vectorizado estilo Gym sobre MatchSim para entrenar agentes.
+    // El agente controla a player1 y player2 usa la IA de updateAI. Cada
+    // episodio es un juego; al terminar, el entorno se reinicia solo con la
+    // siguiente semilla y devuelve la primera observacion del nuevo episodio.
+    // step() escribe en buffers del llamador y no reserva memoria. Las
+    // pelotas sin efecto de cada bloque de partidos se integran juntas con
+    // BallFlight::integrateBatch cuando la simulacion es Q16.16.
+    class VecEnv {
+    public:
+        static const int OBSERVATION_SIZE = 12;
+
+        enum Action : uint8_t {
+            NOOP,
+            LEFT,
+            RIGHT,
+            SWING,
+            SWING_LEFT,
+            SWING_RIGHT,
+            ACTION_COUNT
+        };
+
+        // threadCount <= 1 ejecuta todo en el hilo llamador.
+        VecEnv(int envCount, int threadCount = 1, float frameTime = 1.0f / 60.0f);
+
+        int size() const { return static_cast<int>(envs.size()); }
+
+        // observations: size() * OBSERVATION_SIZE floats.
+        void reset(const uint64_t* seeds, float* observations);
+        // actions: size(); rewards: size(); dones: size().
+        void step(const uint8_t* actions, float* observations, float* rewards, uint8_t* dones);
+
+    private:
+        void stepRange(int begin, int end);
+        void writeObservation(int index, float* observation) const;
+
+        typedef MatchStepper<HumanPolicy, ScriptedAIPolicy> Stepper;
+
+        std::vector<MatchSim> envs;
+        std::vector<Stepper> steppers;
+        std::vector<uint64_t> seeds;
+        std::vector<MatchSim::StepResult> results;
+        // Pelotas por columnas (raw Q16.16) para integrateBatch.
+        std::vector<uint8_t> flying;
+        std::vector<int32_t> ballX;
+        std::vector<int32_t> ballY;
+        std::vector<int32_t> ballVX;
+        std::vector<int32_t> ballVY;
+        std::unique_ptr<ThreadPool> pool;
+        float frameTime;
+
+        const uint8_t* stepActions = nullptr;
+        float* stepObservations = nullptr;
+        float* stepRewards = nullptr;
+        uint8_t* stepDones = nullptr;
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -12,6 +12,8 @@ int WINAPI WinMain(
     UNREFERENCED_PARAMETER(hPrevInstance);
     UNREFERENCED_PARAMETER(lpCmdLine);
     EpicGame::AppDelegate app;
+    app.parseReplayExportArgs(__argc, __argv);
+    app.parseInputLatencyArgs(__argc, __argv);
 
     return cocos2d::Application::getInstance()->run();
 }
@@ -20,5 +22,7 @@ int main(int argc, char* argv[])
 {
   
     EpicGame::AppDelegate app;
+    app.parseReplayExportArgs(argc, argv);
+    app.parseInputLatencyArgs(argc, argv);
     return cocos2d::Application::getInstance()->run();
 }